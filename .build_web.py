@@ -0,0 +1,180 @@
+#
+# Minifies and gzips the web UI in web/ into PROGMEM arrays in
+# lib/WebStrings/WebAssets.h.
+#
+# Runs as a PlatformIO pre-build script, or standalone:
+#
+#   python3 .build_web.py
+#
+# The header is only rewritten when its contents change so that unchanged
+# assets don't trigger a rebuild.
+#
+# PlatformIO runs this with its own interpreter, so it has to work with both
+# Python 2.7 and 3.
+#
+import gzip
+import hashlib
+import io
+import os
+import re
+import sys
+
+try:
+    Import("env")
+    project_dir = env["PROJECT_DIR"]
+except NameError:
+    project_dir = os.path.dirname(os.path.realpath(__file__))
+
+WEB_DIR = os.path.join(project_dir, "web")
+OUTPUT_FILE = os.path.join(project_dir, "lib", "WebStrings", "WebAssets.h")
+
+# Upper bound on the combined gzipped size of all assets, in bytes.  The build
+# fails if it's exceeded.
+SIZE_BUDGET = 6 * 1024
+
+# Stylesheet and script URLs in index.html are rewritten to include a content
+# hash, so those can be cached indefinitely.  The page itself is revalidated.
+IMMUTABLE_CACHE_CONTROL = "public, max-age=31536000, immutable"
+REVALIDATE_CACHE_CONTROL = "no-cache"
+
+def minify_css(s):
+    s = re.sub(r"/\*.*?\*/", "", s, flags=re.S)
+    s = re.sub(r"\s+", " ", s)
+    s = re.sub(r"\s*([{}:;,>])\s*", r"\1", s)
+    return s.replace(";}", "}").strip()
+
+def minify_js(s):
+    # Conservative: only strips indentation, blank lines and whole-line
+    # comments, so string and regex literals are never touched
+    lines = []
+
+    for line in s.splitlines():
+        line = line.strip()
+
+        if line and not line.startswith("//"):
+            lines.append(line)
+
+    return "\n".join(lines)
+
+def minify_html(s):
+    s = re.sub(r"<!--.*?-->", "", s, flags=re.S)
+    s = re.sub(r">\s+<", "><", s)
+    s = re.sub(r"\s+", " ", s)
+    return s.strip()
+
+def content_hash(data):
+    return hashlib.sha1(data).hexdigest()[:16]
+
+def compress(data):
+    # Fixed mtime so that output only depends on the input.  gzip.compress()
+    # is Python 3 only, and only takes an mtime from 3.8.
+    out = io.BytesIO()
+
+    with gzip.GzipFile(fileobj=out, mode="wb", compresslevel=9, mtime=0) as f:
+        f.write(data)
+
+    return out.getvalue()
+
+def fail(message):
+    sys.stderr.write("Error building web assets: %s\n" % message)
+    sys.exit(1)
+
+class Asset:
+    def __init__(self, name, path, content_type, minify, cache_control):
+        self.name = name
+        self.path = path
+        self.content_type = content_type
+        self.minify = minify
+        self.cache_control = cache_control
+
+    def build(self, substitutions={}):
+        with io.open(os.path.join(WEB_DIR, self.path), "r", encoding="utf-8") as f:
+            source = f.read()
+
+        for (original, replacement) in substitutions.items():
+            source = source.replace(original, replacement)
+
+        # The UI has to work without internet access
+        external = re.search(r"(?:src|href)=[\"']?(?:https?:)?//", source)
+        if external:
+            fail("%s loads an external resource: %s" % (self.path, external.group(0)))
+
+        self.source_size = len(source.encode("utf-8"))
+        self.data = compress(self.minify(source).encode("utf-8"))
+        self.etag = content_hash(self.data)
+
+    def declaration(self):
+        lines = []
+        lines.append("// %s: %d bytes, %d gzipped" % (self.path, self.source_size, len(self.data)))
+        lines.append("const uint8_t %s_GZ[] PROGMEM = {" % self.name)
+
+        for i in range(0, len(self.data), 16):
+            # bytearray yields ints on both Python 2 and 3
+            chunk = bytearray(self.data[i:i+16])
+            lines.append("  " + ", ".join("0x%02x" % b for b in chunk) + ",")
+
+        lines.append("};")
+        lines.append('const WebAsset %s = { %s_GZ, sizeof(%s_GZ), "%s", "\\"%s\\"", "%s" };' % (
+            self.name, self.name, self.name, self.content_type, self.etag, self.cache_control
+        ))
+
+        return "\n".join(lines)
+
+def build():
+    stylesheet = Asset("STYLESHEET", "style.css", "text/css", minify_css, IMMUTABLE_CACHE_CONTROL)
+    javascript = Asset("JAVASCRIPT", "script.js", "application/javascript", minify_js, IMMUTABLE_CACHE_CONTROL)
+    index = Asset("INDEX_PAGE", "index.html", "text/html", minify_html, REVALIDATE_CACHE_CONTROL)
+
+    stylesheet.build()
+    javascript.build()
+    index.build({
+        '"/style.css"': '"/style.css?v=%s"' % stylesheet.etag,
+        '"/script.js"': '"/script.js?v=%s"' % javascript.etag
+    })
+
+    assets = [index, javascript, stylesheet]
+    total_size = sum(len(asset.data) for asset in assets)
+
+    if total_size > SIZE_BUDGET:
+        fail("%d bytes gzipped exceeds the budget of %d bytes" % (total_size, SIZE_BUDGET))
+
+    header = "\n".join([
+        "// Generated by .build_web.py from the files in web/.  Do not edit.",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "#include <pgmspace.h>",
+        "",
+        "#ifndef _WEB_ASSETS_H",
+        "#define _WEB_ASSETS_H",
+        "",
+        "// A gzipped asset and the headers to serve it with",
+        "struct WebAsset {",
+        "  const uint8_t* data;",
+        "  size_t length;",
+        "  const char* contentType;",
+        "  const char* etag;",
+        "  const char* cacheControl;",
+        "};",
+        "",
+        "\n\n".join(asset.declaration() for asset in assets),
+        "",
+        "#endif",
+        ""
+    ])
+
+    existing = None
+    if os.path.exists(OUTPUT_FILE):
+        with open(OUTPUT_FILE, "r") as f:
+            existing = f.read()
+
+    if header != existing:
+        with open(OUTPUT_FILE, "w") as f:
+            f.write(header)
+
+    for asset in assets:
+        print("Web asset %s: %d bytes -> %d gzipped" % (asset.path, asset.source_size, len(asset.data)))
+
+    print("Web assets: %d of %d bytes budget" % (total_size, SIZE_BUDGET))
+
+build()
@@ -0,0 +1,91 @@
+#include <FlagServerProbe.h>
+
+FlagServerProbe::FlagServerProbe()
+  : client(NULL)
+  , responseLength(0)
+  , startedAt(0)
+  , timeout(0)
+  , started(false)
+  , done(false)
+{
+  response[0] = 0;
+}
+
+FlagServerProbe::~FlagServerProbe() {
+  if (client != NULL) {
+    client->close(true);
+    delete client;
+  }
+}
+
+void FlagServerProbe::begin(const char* host, uint16_t port, unsigned long timeout) {
+  this->timeout = timeout;
+  this->startedAt = millis();
+  this->started = true;
+
+  client = new AsyncClient();
+
+  client->onConnect([](void* arg, AsyncClient* c) {
+    Serial.println(F("Connected to flag server"));
+  }, this);
+
+  client->onData([](void* arg, AsyncClient* c, void* data, size_t len) {
+    static_cast<FlagServerProbe*>(arg)->handleData(static_cast<const char*>(data), len);
+  }, this);
+
+  client->onDisconnect([](void* arg, AsyncClient* c) {
+    static_cast<FlagServerProbe*>(arg)->finish(F("disconnected"));
+  }, this);
+
+  client->onError([](void* arg, AsyncClient* c, int8_t error) {
+    static_cast<FlagServerProbe*>(arg)->finish(F("connection error"));
+  }, this);
+
+  if (! client->connect(host, port)) {
+    finish(F("failed to connect"));
+  }
+}
+
+void FlagServerProbe::handleData(const char* data, size_t len) {
+  size_t toCopy = min(len, FLAG_SERVER_MAX_RESPONSE_LENGTH - responseLength);
+
+  memcpy(response + responseLength, data, toCopy);
+  responseLength += toCopy;
+  response[responseLength] = 0;
+
+  // No need to wait for the server to hang up once it has sent the flag
+  if (strcmp(response, FLAG_SERVER_UPDATE_COMMAND) == 0) {
+    finish(F("received update flag"));
+  }
+}
+
+void FlagServerProbe::finish(const __FlashStringHelper* reason) {
+  if (done) {
+    return;
+  }
+
+  done = true;
+
+  Serial.print(F("Flag server probe finished: "));
+  Serial.println(reason);
+
+  if (client != NULL && client->connected()) {
+    client->close();
+  }
+}
+
+bool FlagServerProbe::isStarted() const {
+  return started;
+}
+
+bool FlagServerProbe::isDone() {
+  if (started && !done && (millis() - startedAt) >= timeout) {
+    finish(F("timed out"));
+  }
+
+  return done;
+}
+
+bool FlagServerProbe::isUpdateRequested() const {
+  return done && strcmp(response, FLAG_SERVER_UPDATE_COMMAND) == 0;
+}
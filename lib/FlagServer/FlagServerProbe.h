@@ -0,0 +1,38 @@
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>
+
+#ifndef _FLAG_SERVER_PROBE_H
+#define _FLAG_SERVER_PROBE_H
+
+#define FLAG_SERVER_UPDATE_COMMAND "update"
+#define FLAG_SERVER_MAX_RESPONSE_LENGTH 16
+
+// Asks the flag server whether to boot into settings mode without blocking.
+// The connection runs on ESPAsyncTCP in the background; the result is
+// available once the server has answered, disconnected, or the deadline has
+// passed, whichever comes first.
+class FlagServerProbe {
+public:
+  FlagServerProbe();
+  ~FlagServerProbe();
+
+  void begin(const char* host, uint16_t port, unsigned long timeout);
+
+  bool isStarted() const;
+  bool isDone();
+  bool isUpdateRequested() const;
+
+private:
+  AsyncClient* client;
+  char response[FLAG_SERVER_MAX_RESPONSE_LENGTH + 1];
+  size_t responseLength;
+  unsigned long startedAt;
+  unsigned long timeout;
+  bool started;
+  bool done;
+
+  void handleData(const char* data, size_t len);
+  void finish(const __FlashStringHelper* reason);
+};
+
+#endif
@@ -0,0 +1,420 @@
+#include <GatewayClient.h>
+#include <HmacHelpers.h>
+#include <Timezone.h>
+
+static const char HTTP_PREFIX[] = "http://";
+
+static time_t signatureTimestamp() {
+  TimeChangeRule dstOn = {"DT", Second, dowSunday, Mar, 2, 60};
+  TimeChangeRule dstOff = {"ST", First, dowSunday, Nov, 2, 0};
+  Timezone timezone(dstOn, dstOff);
+
+  return timezone.toLocal(now());
+}
+
+GatewayClient::GatewayClient(Settings& settings, RuntimeStats& stats)
+  : settings(settings)
+  , stats(stats)
+  , signerGeneration(0)
+  , port(80)
+{
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS; i++) {
+    Slot& slot = slots[i];
+
+    slot.owner = this;
+    slot.client = NULL;
+    slot.state = SlotState::DISCONNECTED;
+    slot.retired = false;
+  }
+}
+
+GatewayClient::~GatewayClient() {
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS; i++) {
+    if (slots[i].client != NULL) {
+      slots[i].client->close(true);
+      delete slots[i].client;
+    }
+  }
+}
+
+bool GatewayClient::put(const String& path, const String& body, Callback callback) {
+  return put(path.c_str(), body.c_str(), callback);
+}
+
+bool GatewayClient::put(const char* path, const char* body, Callback callback) {
+  if (queue.size() >= GATEWAY_MAX_QUEUED_REQUESTS) {
+    stats.gatewayRequestsDropped++;
+    Serial.printf_P(PSTR("Gateway queue full, dropping request to %s\n"), path);
+
+    if (callback) {
+      callback(GATEWAY_ERROR_QUEUE_FULL);
+    }
+
+    return false;
+  }
+
+  if (connectedServer != settings.gatewayServer) {
+    retireConnections();
+    connectedServer = settings.gatewayServer;
+    parseServer();
+  }
+
+  time_t now = signatureTimestamp();
+  size_t pathLength = strlen(path);
+  size_t bodyLength = strlen(body);
+
+  Request request;
+  request.path = path;
+  request.callback = callback;
+  request.retried = false;
+
+  String& payload = request.payload;
+  payload.reserve(bodyLength + 256);
+
+  payload += F("PUT ");
+  payload += basePath;
+  payload += path;
+  payload += F(" HTTP/1.1\r\nHost: ");
+  payload += hostHeader;
+  payload += F("\r\nConnection: keep-alive\r\nContent-Type: application/json\r\nContent-Length: ");
+  payload += bodyLength;
+  payload += F("\r\n");
+
+  if (settings.hmacSecret.length() > 0) {
+    char signature[HMAC_HEX_LENGTH + 1];
+
+    if (! signer.hasKey() || signerGeneration != settings.generation) {
+      signer.setKey(settings.hmacSecret.c_str(), settings.hmacSecret.length());
+      signerGeneration = settings.generation;
+    }
+
+    signer.sign(
+      path, pathLength,
+      body, bodyLength,
+      now,
+      signature
+    );
+
+    payload += F("X-Signature-Timestamp: ");
+    payload += String(now);
+    payload += F("\r\nX-Signature: ");
+    payload += signature;
+    payload += F("\r\n");
+  }
+
+  payload += F("\r\n");
+  payload += body;
+
+  queue.push_back(std::move(request));
+
+  return true;
+}
+
+void GatewayClient::parseServer() {
+  String server = settings.gatewayServer;
+
+  if (server.startsWith(HTTP_PREFIX)) {
+    server = server.substring(strlen(HTTP_PREFIX));
+  }
+
+  // Request paths are appended to the server URL, as in "http://host:8080/api"
+  // + "/sensor"
+  int pathStart = server.indexOf('/');
+  if (pathStart != -1) {
+    basePath = server.substring(pathStart);
+    server = server.substring(0, pathStart);
+  } else {
+    basePath = "";
+  }
+
+  int portStart = server.indexOf(':');
+  if (portStart != -1) {
+    host = server.substring(0, portStart);
+    port = atoi(server.c_str() + portStart + 1);
+  } else {
+    host = server;
+    port = 80;
+  }
+
+  hostHeader = host;
+  if (port != 80) {
+    hostHeader += ':';
+    hostHeader += port;
+  }
+}
+
+// Connections to the old server can't carry requests for the new one.  Idle
+// ones are closed now, and busy ones once their request completes.
+void GatewayClient::retireConnections() {
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS; i++) {
+    Slot& slot = slots[i];
+
+    if (slot.state == SlotState::IDLE) {
+      slot.client->close(true);
+      slot.state = SlotState::DISCONNECTED;
+    } else if (slot.state != SlotState::DISCONNECTED) {
+      slot.retired = true;
+    }
+  }
+}
+
+void GatewayClient::loop() {
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS; i++) {
+    Slot& slot = slots[i];
+
+    if (slot.state == SlotState::COMPLETE) {
+      deliver(slot);
+    } else if (slot.state != SlotState::IDLE
+      && slot.state != SlotState::DISCONNECTED
+      && (millis() - slot.startedAt) >= GATEWAY_REQUEST_TIMEOUT) {
+      slot.keepAlive = false;
+      complete(slot, GATEWAY_ERROR_TIMEOUT);
+      deliver(slot);
+    }
+  }
+
+  // Prefer connections that are already open
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS && !queue.empty(); i++) {
+    if (slots[i].state == SlotState::IDLE) {
+      dispatch(slots[i], queue.front());
+      queue.pop_front();
+    }
+  }
+
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS && !queue.empty(); i++) {
+    if (slots[i].state == SlotState::DISCONNECTED) {
+      dispatch(slots[i], queue.front());
+      queue.pop_front();
+    }
+  }
+}
+
+bool GatewayClient::isIdle() const {
+  if (! queue.empty()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < GATEWAY_MAX_CONNECTIONS; i++) {
+    if (slots[i].state != SlotState::IDLE && slots[i].state != SlotState::DISCONNECTED) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool GatewayClient::waitForSpace(unsigned long timeout) {
+  unsigned long start = millis();
+
+  while (queue.size() >= GATEWAY_MAX_QUEUED_REQUESTS && (millis() - start) < timeout) {
+    loop();
+    delay(1);
+  }
+
+  return queue.size() < GATEWAY_MAX_QUEUED_REQUESTS;
+}
+
+void GatewayClient::flush(unsigned long timeout) {
+  unsigned long start = millis();
+
+  while (! isIdle() && (millis() - start) < timeout) {
+    loop();
+    delay(1);
+  }
+}
+
+void GatewayClient::dispatch(Slot& slot, Request& request) {
+  slot.request = std::move(request);
+  slot.written = 0;
+  slot.startedAt = millis();
+  slot.statusCode = 0;
+  slot.result = 0;
+  slot.keepAlive = false;
+  slot.retired = false;
+  slot.contentLength = -1;
+  slot.bodyRemaining = 0;
+  slot.lineLength = 0;
+
+  stats.gatewayRequestsSent++;
+
+  if (slot.state == SlotState::IDLE) {
+    slot.reused = true;
+    slot.state = SlotState::SENDING;
+    pump(slot);
+    return;
+  }
+
+  slot.reused = false;
+  slot.state = SlotState::CONNECTING;
+
+  if (slot.client == NULL) {
+    slot.client = new AsyncClient();
+
+    slot.client->onConnect([](void* arg, AsyncClient* c) {
+      Slot& slot = *static_cast<Slot*>(arg);
+
+      if (slot.state == SlotState::CONNECTING) {
+        slot.state = SlotState::SENDING;
+        pump(slot);
+      }
+    }, &slot);
+
+    slot.client->onAck([](void* arg, AsyncClient* c, size_t len, uint32_t time) {
+      pump(*static_cast<Slot*>(arg));
+    }, &slot);
+
+    slot.client->onData([](void* arg, AsyncClient* c, void* data, size_t len) {
+      handleData(*static_cast<Slot*>(arg), static_cast<const char*>(data), len);
+    }, &slot);
+
+    slot.client->onDisconnect([](void* arg, AsyncClient* c) {
+      handleDisconnect(*static_cast<Slot*>(arg));
+    }, &slot);
+
+    slot.client->onError([](void* arg, AsyncClient* c, int8_t error) {
+      handleDisconnect(*static_cast<Slot*>(arg));
+    }, &slot);
+  }
+
+  stats.gatewayConnectionsOpened++;
+
+  if (! slot.client->connect(host.c_str(), port)) {
+    complete(slot, GATEWAY_ERROR_CONNECTION_FAILED);
+  }
+}
+
+void GatewayClient::deliver(Slot& slot) {
+  Request& request = slot.request;
+  int result = slot.result;
+
+  if (slot.keepAlive && !slot.retired && slot.client->connected()) {
+    slot.state = SlotState::IDLE;
+  } else {
+    slot.client->close(true);
+    slot.state = SlotState::DISCONNECTED;
+  }
+
+  // An idle keep-alive connection may have been closed by the server under us.
+  // Retry once on a fresh connection.
+  if (result < 0 && slot.reused && !request.retried) {
+    request.retried = true;
+    queue.push_front(std::move(request));
+    return;
+  }
+
+  if (result < 0) {
+    stats.gatewayRequestsFailed++;
+    Serial.printf_P(PSTR("Gateway request to %s failed: %d\n"), request.path.c_str(), result);
+  }
+
+  if (request.callback) {
+    request.callback(result);
+  }
+
+  // Release the payload
+  slot.request = Request();
+}
+
+void GatewayClient::pump(Slot& slot) {
+  if (slot.state != SlotState::SENDING) {
+    return;
+  }
+
+  const String& payload = slot.request.payload;
+  size_t remaining = payload.length() - slot.written;
+  size_t space = slot.client->space();
+
+  if (remaining > 0 && space > 0) {
+    size_t added = slot.client->add(payload.c_str() + slot.written, min(remaining, space));
+    slot.written += added;
+    slot.client->send();
+  }
+
+  if (slot.written == payload.length()) {
+    slot.state = SlotState::AWAITING_RESPONSE;
+  }
+}
+
+void GatewayClient::handleData(Slot& slot, const char* data, size_t len) {
+  size_t i = 0;
+
+  while (i < len) {
+    if (slot.state == SlotState::AWAITING_RESPONSE) {
+      char c = data[i++];
+
+      if (c == '\n') {
+        slot.line[slot.lineLength] = 0;
+        handleHeaderLine(slot);
+        slot.lineLength = 0;
+      } else if (c != '\r' && slot.lineLength < (GATEWAY_MAX_HEADER_LINE - 1)) {
+        slot.line[slot.lineLength++] = c;
+      }
+    } else if (slot.state == SlotState::READING_BODY) {
+      // The body is discarded; just account for it so the connection can be reused
+      size_t n = min(static_cast<long>(len - i), slot.bodyRemaining);
+      i += n;
+      slot.bodyRemaining -= n;
+
+      if (slot.bodyRemaining == 0) {
+        complete(slot, slot.statusCode);
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+void GatewayClient::handleHeaderLine(Slot& slot) {
+  const char* line = slot.line;
+
+  if (slot.statusCode == 0) {
+    // Status line: "HTTP/1.1 200 OK"
+    if (strncmp_P(line, PSTR("HTTP/1."), 7) == 0 && slot.lineLength > 9) {
+      slot.statusCode = atoi(line + 9);
+      slot.keepAlive = line[7] == '1';
+    } else {
+      complete(slot, GATEWAY_ERROR_CONNECTION_LOST);
+    }
+  } else if (slot.lineLength == 0) {
+    // End of headers.  Without a length we can't find the end of the body, so
+    // give up on reusing the connection.
+    if (slot.contentLength > 0) {
+      slot.bodyRemaining = slot.contentLength;
+      slot.state = SlotState::READING_BODY;
+    } else {
+      if (slot.contentLength < 0) {
+        slot.keepAlive = false;
+      }
+      complete(slot, slot.statusCode);
+    }
+  } else if (strncasecmp_P(line, PSTR("Content-Length:"), 15) == 0) {
+    slot.contentLength = atol(line + 15);
+  } else if (strncasecmp_P(line, PSTR("Connection:"), 11) == 0 && strstr_P(line, PSTR("close")) != NULL) {
+    slot.keepAlive = false;
+  }
+}
+
+void GatewayClient::handleDisconnect(Slot& slot) {
+  switch (slot.state) {
+    case SlotState::IDLE:
+      slot.state = SlotState::DISCONNECTED;
+      break;
+
+    case SlotState::COMPLETE:
+    case SlotState::DISCONNECTED:
+      slot.keepAlive = false;
+      break;
+
+    default:
+      // Connection closed mid-request.  If we already have a status, the server
+      // just didn't bother with a length or keep-alive.
+      slot.keepAlive = false;
+      complete(slot, slot.statusCode > 0 ? slot.statusCode : GATEWAY_ERROR_CONNECTION_LOST);
+      break;
+  }
+}
+
+void GatewayClient::complete(Slot& slot, int result) {
+  slot.result = result;
+  slot.state = SlotState::COMPLETE;
+}
@@ -0,0 +1,131 @@
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>
+#include <Settings.h>
+#include <RuntimeStats.h>
+#include <HmacHelpers.h>
+#include <functional>
+#include <deque>
+#include <utility>
+
+#ifndef _GATEWAY_CLIENT_H
+#define _GATEWAY_CLIENT_H
+
+// Number of requests that can be in flight at once, each on its own connection
+#ifndef GATEWAY_MAX_CONNECTIONS
+#define GATEWAY_MAX_CONNECTIONS 2
+#endif
+
+// Maximum number of requests waiting for a connection
+#ifndef GATEWAY_MAX_QUEUED_REQUESTS
+#define GATEWAY_MAX_QUEUED_REQUESTS 16
+#endif
+
+#ifndef GATEWAY_REQUEST_TIMEOUT
+#define GATEWAY_REQUEST_TIMEOUT 5000
+#endif
+
+#define GATEWAY_MAX_HEADER_LINE 64
+
+#define GATEWAY_ERROR_CONNECTION_FAILED -1
+#define GATEWAY_ERROR_CONNECTION_LOST -5
+#define GATEWAY_ERROR_TIMEOUT -11
+#define GATEWAY_ERROR_QUEUE_FULL -100
+
+// Pushes readings to the HTTP gateway without blocking the main loop.
+//
+// Requests are queued and sent over a small pool of ESPAsyncTCP connections,
+// which are kept alive and reused across sensors and update intervals.  Each
+// request has a deadline, and completion callbacks are delivered from loop()
+// rather than from the TCP stack's context.
+class GatewayClient {
+public:
+  // Receives the HTTP status code, or a negative GATEWAY_ERROR_* code
+  typedef std::function<void(int)> Callback;
+
+  GatewayClient(Settings& settings, RuntimeStats& stats);
+  ~GatewayClient();
+
+  // Queues a signed PUT to the given path on the gateway server.  Never waits:
+  // if the queue is full, the request is dropped, the callback receives
+  // GATEWAY_ERROR_QUEUE_FULL, and false is returned.
+  bool put(const char* path, const char* body, Callback callback = NULL);
+  bool put(const String& path, const String& body, Callback callback = NULL);
+
+  void loop();
+  bool isIdle() const;
+
+  // Drives loop() until the queue has room for another request.  A slot frees
+  // up within GATEWAY_REQUEST_TIMEOUT, so that's the most this needs to wait.
+  // Returns false if the queue is still full after timeout ms.
+  bool waitForSpace(unsigned long timeout = GATEWAY_REQUEST_TIMEOUT);
+
+  // Drives loop() until all requests have completed or timeout ms have passed
+  void flush(unsigned long timeout);
+
+private:
+  struct Request {
+    String path;
+    String payload;
+    Callback callback;
+    bool retried;
+  };
+
+  enum class SlotState {
+    DISCONNECTED,
+    CONNECTING,
+    SENDING,
+    AWAITING_RESPONSE,
+    READING_BODY,
+    COMPLETE,
+    IDLE
+  };
+
+  struct Slot {
+    GatewayClient* owner;
+    AsyncClient* client;
+    SlotState state;
+    Request request;
+    bool reused;
+    size_t written;
+    unsigned long startedAt;
+
+    int statusCode;
+    int result;
+    bool keepAlive;
+    // Set when the gateway server changes mid-request, so the connection is
+    // closed rather than reused for the new server
+    bool retired;
+    long contentLength;
+    long bodyRemaining;
+    char line[GATEWAY_MAX_HEADER_LINE];
+    size_t lineLength;
+  };
+
+  Settings& settings;
+  RuntimeStats& stats;
+  Slot slots[GATEWAY_MAX_CONNECTIONS];
+  std::deque<Request> queue;
+  String connectedServer;
+  RequestSigner signer;
+  // Settings generation the signer's key was taken from
+  uint32_t signerGeneration;
+  String host;
+  uint16_t port;
+  // Value of the Host header: the host, plus the port if it isn't 80
+  String hostHeader;
+  // Path part of the server URL, prepended to each request's path
+  String basePath;
+
+  void parseServer();
+  void dispatch(Slot& slot, Request& request);
+  void deliver(Slot& slot);
+  void retireConnections();
+
+  static void pump(Slot& slot);
+  static void handleData(Slot& slot, const char* data, size_t len);
+  static void handleHeaderLine(Slot& slot);
+  static void handleDisconnect(Slot& slot);
+  static void complete(Slot& slot, int result);
+};
+
+#endif
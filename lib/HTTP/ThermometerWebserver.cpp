@@ -1,9 +1,7 @@
 #include <ThermometerWebserver.h>
 #include <Updater.h>
-#include <IndexPage.h>
-#include <Javascript.h>
-#include <Stylesheet.h>
-#include <IntParsing.h>
+#include <WebAssets.h>
+#include <StreamString.h>
 #include <map>
 
 #if defined(ESP8266)
@@ -12,20 +10,27 @@
 #include <Update.h>
 #endif
 
-static const char TEXT_HTML[] = "text/html";
 static const char TEXT_PLAIN[] = "text/plain";
 static const char APPLICATION_JSON[] = "application/json";
 
 static const char CONTENT_TYPE_HEADER[] = "Content-Type";
+static const char ETAG_HEADER[] = "ETag";
+static const char IF_NONE_MATCH_HEADER[] = "If-None-Match";
+static const char CACHE_CONTROL_HEADER[] = "Cache-Control";
+static const char CONTENT_ENCODING_HEADER[] = "Content-Encoding";
 
 using namespace std::placeholders;
 
-ThermometerWebserver::ThermometerWebserver(TempIface& sensors, Settings& settings)
+ThermometerWebserver::ThermometerWebserver(TempIface& sensors, SensorRegistry& registry, Settings& settings, const RuntimeStats& stats)
   : authProvider(settings)
   , server(RichHttpServer<RichHttpConfig>(settings.webPort, authProvider))
   , sensors(sensors)
+  , registry(registry)
   , settings(settings)
+  , stats(stats)
   , port(settings.webPort)
+  , settingsCacheGeneration(0)
+  , settingsCacheValid(false)
 { }
 
 ThermometerWebserver::~ThermometerWebserver() {
@@ -63,13 +68,13 @@ void ThermometerWebserver::begin() {
 
   server
     .buildHandler("/")
-    .on(HTTP_GET, std::bind(&ThermometerWebserver::serveProgmemStr, this, INDEX_PAGE_HTML, TEXT_HTML, _1));
+    .on(HTTP_GET, std::bind(&ThermometerWebserver::serveAsset, this, std::cref(INDEX_PAGE), _1));
   server
     .buildHandler("/style.css")
-    .on(HTTP_GET, std::bind(&ThermometerWebserver::serveProgmemStr, this, STYLESHEET, "text/css", _1));
+    .on(HTTP_GET, std::bind(&ThermometerWebserver::serveAsset, this, std::cref(STYLESHEET), _1));
   server
     .buildHandler("/script.js")
-    .on(HTTP_GET, std::bind(&ThermometerWebserver::serveProgmemStr, this, JAVASCRIPT, "application/javascript", _1));
+    .on(HTTP_GET, std::bind(&ThermometerWebserver::serveAsset, this, std::cref(JAVASCRIPT), _1));
 
   server.clearBuilders();
   server.begin();
@@ -103,60 +108,48 @@ void ThermometerWebserver::handleCreateCommand(RequestContext& request) {
 
 void ThermometerWebserver::handleListThermometers(RequestContext& request) {
   JsonArray thermometers = request.response.json.to<JsonArray>();
-  const std::map<String, uint8_t*>& sensorIds = sensors.thermometerIds();
 
-  for (std::map<String, uint8_t*>::const_iterator itr = sensorIds.begin(); itr != sensorIds.end(); ++itr) {
+  registry.refresh();
+
+  for (size_t i = 0; i < sensors.probeCount(); i++) {
+    const TempIface::Probe& probe = sensors.probe(i);
+    const SensorRecord* sensor = registry.find(probe.rom);
     JsonObject therm = thermometers.createNestedObject();
 
-    if (settings.deviceAliases.count(itr->first) > 0) {
-      therm["name"] = settings.deviceAliases[itr->first];
+    if (sensor->hasAlias) {
+      therm["name"] = sensor->name;
     }
 
-    therm["temperature"] = sensors.lastSeenTemp(itr->first);
-    therm["id"] = itr->first;
+    therm["temperature"] = probe.temperature;
+    therm["resolution"] = probe.resolution;
+    therm["id"] = sensor->id;
   }
 }
 
 void ThermometerWebserver::handleGetThermometer(RequestContext& request) {
   if (request.pathVariables.hasBinding("thermometer")) {
     const char* thermometer = request.pathVariables.get("thermometer");
-    uint8_t addr[8];
-    String name;
-
-    // If the provided token is an ID we have an alias for
-    if (settings.deviceAliases.count(thermometer) > 0) {
-      name = settings.deviceAliases[thermometer];
-      hexStrToBytes(thermometer, strlen(thermometer), addr, 8);
-    // Otherwise, if it's an alias, try to find it
-    } else {
-      bool found = false;
-
-      for (std::map<String, String>::iterator itr = settings.deviceAliases.begin(); itr != settings.deviceAliases.end(); ++itr) {
-        if (itr->second == thermometer) {
-          hexStrToBytes(itr->first.c_str(), itr->first.length(), addr, 8);
-          name = thermometer;
-          found = true;
-          break;
-        }
-      }
-
-      // Try to treat it as an address
-      if (!found) {
-        hexStrToBytes(thermometer, strlen(thermometer), addr, 8);
-      }
+
+    registry.refresh();
+
+    // Either a device ID or an alias
+    const SensorRecord* sensor = registry.findById(thermometer);
+    uint64_t rom;
+
+    if (sensor == NULL && settings.findAliasedDevice(thermometer, rom)) {
+      sensor = registry.find(rom);
     }
 
-    char addrStr[50];
-    IntParsing::bytesToHexStr(addr, 8, addrStr, sizeof(addrStr)-1);
+    const TempIface::Probe* probe = sensor != NULL ? sensors.find(sensor->rom) : NULL;
 
-    if (sensors.hasSeenId(addrStr)) {
+    if (probe != NULL
+      && probe->status != TempIface::ProbeStatus::NO_READING
+      && probe->status != TempIface::ProbeStatus::RESTORED) {
       JsonObject json = request.response.json.to<JsonObject>();
 
-      float temp = sensors.lastSeenTemp(addrStr);
-
-      json["id"] = addrStr;
-      json["name"] = name;
-      json["current_temperature"] = temp;
+      json["id"] = sensor->id;
+      json["name"] = sensor->hasAlias ? sensor->name : "";
+      json["current_temperature"] = probe->temperature;
     } else {
       request.response.json["error"] = F("Could not find the provided thermometer");
       request.response.setCode(404);
@@ -167,8 +160,22 @@ void ThermometerWebserver::handleGetThermometer(RequestContext& request) {
   }
 }
 
-void ThermometerWebserver::serveProgmemStr(const char* pgmStr, const char* contentType, RequestContext& request) {
-  request.rawRequest->send_P(200, contentType, pgmStr);
+bool ThermometerWebserver::isNotModified(RequestContext& request, const char* etag) {
+  return request.rawRequest->hasHeader(IF_NONE_MATCH_HEADER)
+    && request.rawRequest->getHeader(IF_NONE_MATCH_HEADER)->value() == etag;
+}
+
+void ThermometerWebserver::serveAsset(const WebAsset& asset, RequestContext& request) {
+  if (isNotModified(request, asset.etag)) {
+    request.rawRequest->send(304);
+    return;
+  }
+
+  AsyncWebServerResponse* response = request.rawRequest->beginResponse_P(200, asset.contentType, asset.data, asset.length);
+  response->addHeader(CONTENT_ENCODING_HEADER, F("gzip"));
+  response->addHeader(ETAG_HEADER, asset.etag);
+  response->addHeader(CACHE_CONTROL_HEADER, asset.cacheControl);
+  request.rawRequest->send(response);
 }
 
 void ThermometerWebserver::handleAbout(RequestContext& request) {
@@ -183,6 +190,16 @@ void ThermometerWebserver::handleAbout(RequestContext& request) {
   res["signal_strength"] = WiFi.RSSI();
   res["free_heap"] = freeHeap;
   res["sdk_version"] = ESP.getSdkVersion();
+  res["sensor_read_ms"] = sensors.lastReadDuration();
+  res["wifi_connect_ms"] = stats.wifiConnectMillis;
+  res["wifi_fast_connect"] = stats.wifiFastConnect;
+  res["gateway_connections_opened"] = stats.gatewayConnectionsOpened;
+  res["gateway_requests_sent"] = stats.gatewayRequestsSent;
+  res["gateway_requests_failed"] = stats.gatewayRequestsFailed;
+  res["gateway_requests_dropped"] = stats.gatewayRequestsDropped;
+  res["readings_not_buffered"] = stats.readingsNotBuffered;
+  res["settings_save_ms"] = settings.lastSaveDuration;
+  res["settings_flash_writes"] = settings.flashWrites;
 }
 
 void ThermometerWebserver::handleUpdateSettings(RequestContext& request) {
@@ -194,12 +211,65 @@ void ThermometerWebserver::handleUpdateSettings(RequestContext& request) {
     return;
   }
 
-  settings.patch(req);
-  settings.save();
+  String error;
+
+  if (! Settings::validate(req, error)) {
+    request.response.json["error"] = error;
+    request.response.setCode(400);
+    return;
+  }
 
-  request.rawRequest->send(SPIFFS, SETTINGS_FILE, APPLICATION_JSON);
+  ChangedFields changed;
+
+  // Only touch flash when something actually changed
+  if (settings.patch(req, changed)) {
+    for (ChangedFields::iterator itr = changed.begin(); itr != changed.end(); ++itr) {
+      Serial.printf_P(PSTR("Setting changed: %s\n"), *itr);
+    }
+
+    settings.save();
+  }
+
+  handleListSettings(request);
+}
+
+void ThermometerWebserver::refreshSettingsCache() {
+  if (settingsCacheValid && settingsCacheGeneration == settings.generation) {
+    return;
+  }
+
+  StreamString json;
+  settings.serialize(json, false, true);
+  settingsCache = json;
+
+  // The generation restarts at boot, so mix in the persisted write count and
+  // firmware version to keep tags from being reused for different content
+  char etag[64];
+  snprintf_P(
+    etag,
+    sizeof(etag),
+    PSTR("\"%s-%x-%x\""),
+    QUOTE(ESP8266_THERMOMETER_VERSION),
+    settings.flashWrites,
+    settings.generation
+  );
+  settingsETag = etag;
+
+  settingsCacheGeneration = settings.generation;
+  settingsCacheValid = true;
 }
 
 void ThermometerWebserver::handleListSettings(RequestContext& request) {
-  request.rawRequest->send(SPIFFS, SETTINGS_FILE, APPLICATION_JSON);
+  refreshSettingsCache();
+
+  if (isNotModified(request, settingsETag.c_str())) {
+    request.rawRequest->send(304);
+    return;
+  }
+
+  AsyncWebServerResponse* response = request.rawRequest->beginResponse(200, APPLICATION_JSON, settingsCache);
+  response->addHeader(ETAG_HEADER, settingsETag);
+  // Browsers may keep the response, but must check the tag before using it
+  response->addHeader(CACHE_CONTROL_HEADER, F("no-cache"));
+  request.rawRequest->send(response);
 }
\ No newline at end of file
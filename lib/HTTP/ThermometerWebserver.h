@@ -1,18 +1,22 @@
 #include <FS.h>
 #include <Settings.h>
 #include <TempIface.h>
+#include <SensorRegistry.h>
+#include <RuntimeStats.h>
 
 #include <RichHttpServer.h>
 
 #ifndef _WEB_SERVER_H
 #define _WEB_SERVER_H
 
+struct WebAsset;
+
 using RichHttpConfig = RichHttp::Generics::Configs::AsyncWebServer;
 using RequestContext = RichHttpConfig::RequestContextType;
 
 class ThermometerWebserver {
 public:
-  ThermometerWebserver(TempIface& sensors, Settings& settings);
+  ThermometerWebserver(TempIface& sensors, SensorRegistry& registry, Settings& settings, const RuntimeStats& stats);
   ~ThermometerWebserver();
 
   void begin();
@@ -22,9 +26,17 @@ private:
   PassthroughAuthProvider<Settings> authProvider;
   RichHttpServer<RichHttpConfig> server;
   TempIface& sensors;
+  SensorRegistry& registry;
   Settings& settings;
+  const RuntimeStats& stats;
   uint16_t port;
 
+  // Redacted settings JSON served by GET /settings, rebuilt when settings change
+  String settingsCache;
+  String settingsETag;
+  uint32_t settingsCacheGeneration;
+  bool settingsCacheValid;
+
   // Special routes
   void handleAbout(RequestContext& request);
   void handleOtaUpdate(RequestContext& request);
@@ -37,7 +49,9 @@ private:
   void handleListThermometers(RequestContext& request);
   void handleGetThermometer(RequestContext& request);
 
-  void serveProgmemStr(const char* pgmStr, const char* contentType, RequestContext& request);
+  void refreshSettingsCache();
+  bool isNotModified(RequestContext& request, const char* etag);
+  void serveAsset(const WebAsset& asset, RequestContext& request);
 };
 
 #endif
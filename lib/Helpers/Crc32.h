@@ -0,0 +1,25 @@
+#ifndef _CRC32_H
+#define _CRC32_H
+
+#include <Arduino.h>
+
+class Crc32 {
+public:
+  // Standard CRC-32 (IEEE 802.3, reflected).  Bitwise rather than table-driven
+  // to keep it out of RAM; inputs here are a few hundred bytes at most.
+  static uint32_t compute(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    crc = ~crc;
+
+    for (size_t i = 0; i < length; i++) {
+      crc ^= data[i];
+
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+      }
+    }
+
+    return ~crc;
+  }
+};
+
+#endif
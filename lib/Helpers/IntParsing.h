@@ -2,26 +2,71 @@
 #define _INTPARSING_H
 
 #include <Arduino.h>
+#include <algorithm>
 
+#define INVALID_HEX_DIGIT 0xFF
+
+constexpr char HEX_DIGITS_UPPER[] = "0123456789ABCDEF";
+constexpr char HEX_DIGITS_LOWER[] = "0123456789abcdef";
+
+// Values of the characters '0' through 'f'.  Indexed from '0' rather than
+// covering all 256 characters to keep it small; it lives in RAM.
+constexpr uint8_t HEX_DIGIT_VALUES[] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9,                             // 0-9
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,                 // :;<=>?@
+  10, 11, 12, 13, 14, 15,                                   // A-F
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,                       // G-`
+  10, 11, 12, 13, 14, 15                                    // a-f
+};
+
+// Value of a hex digit, or INVALID_HEX_DIGIT.  Characters below '0' wrap
+// around to large indexes, so one comparison covers both ends of the table.
+constexpr uint8_t hexDigitValue(char c) {
+  return static_cast<uint8_t>(c - '0') < sizeof(HEX_DIGIT_VALUES)
+    ? HEX_DIGIT_VALUES[static_cast<uint8_t>(c - '0')]
+    : INVALID_HEX_DIGIT;
+}
+
+// Parses exactly length hex digits into value.  Fails without touching value
+// if any character isn't a hex digit or if the digits don't fit in T.
+template <typename T>
+bool parseHex(const char* s, size_t length, T& value) {
+  if (length == 0 || length > sizeof(T) * 2) {
+    return false;
+  }
+
+  T result = 0;
+
+  for (size_t i = 0; i < length; i++) {
+    const uint8_t digit = hexDigitValue(s[i]);
+
+    if (digit == INVALID_HEX_DIGIT) {
+      return false;
+    }
+
+    result = (result << 4) | digit;
+  }
+
+  value = result;
+  return true;
+}
+
+// Lenient version of parseHex: stops at the first character that isn't a hex
+// digit, and keeps the low-order digits if there are too many to fit in T.
 template <typename T>
 const T strToHex(const char* s, size_t length) {
   T value = 0;
-  T base = 1;
-
-  for (int i = length-1; i >= 0; i--) {
-    const char c = s[i];
-
-    if (c >= '0' && c <= '9') {
-      value += ((c - '0') * base);
-    } else if (c >= 'a' && c <= 'f') {
-      value += ((c - 'a' + 10) * base);
-    } else if (c >= 'A' && c <= 'F') {
-      value += ((c - 'A' + 10) * base);
-    } else {
+
+  for (size_t i = 0; i < length; i++) {
+    const uint8_t digit = hexDigitValue(s[i]);
+
+    if (digit == INVALID_HEX_DIGIT) {
       break;
     }
 
-    base <<= 4;
+    value = (value << 4) | digit;
   }
 
   return value;
@@ -35,34 +80,65 @@ const T strToHex(const String& s) {
 template <typename T>
 const T parseInt(const String& s) {
   if (s.startsWith("0x")) {
-    return strToHex<T>(s.substring(2));
+    return strToHex<T>(s.c_str() + 2, s.length() - 2);
   } else {
     return s.toInt();
   }
 }
 
+// Decodes pairs of hex digits, optionally separated by spaces, into at most
+// maxLen bytes.  Stops at the first pair that isn't valid hex.  Returns the
+// number of bytes written.
 template <typename T>
-void hexStrToBytes(const char* s, const size_t sLen, T* buffer, size_t maxLen) {
-  int idx = 0;
+size_t hexStrToBytes(const char* s, const size_t sLen, T* buffer, size_t maxLen) {
+  size_t idx = 0;
+
+  for (size_t i = 0; i + 1 < sLen && idx < maxLen; ) {
+    const uint8_t high = hexDigitValue(s[i]);
+    const uint8_t low = hexDigitValue(s[i + 1]);
+
+    if (high == INVALID_HEX_DIGIT || low == INVALID_HEX_DIGIT) {
+      break;
+    }
 
-  for (int i = 0; i < sLen && idx < maxLen; ) {
-    buffer[idx++] = strToHex<T>(s+i, 2);
-    i+= 2;
+    buffer[idx++] = (high << 4) | low;
+    i += 2;
 
-    while (i < (sLen - 1) && s[i] == ' ') {
+    while (i < sLen && s[i] == ' ') {
       i++;
     }
   }
+
+  return idx;
 }
 
 class IntParsing {
 public:
-  static void bytesToHexStr(const uint8_t* bytes, const size_t len, char* buffer, size_t maxLen) {
+  // Writes the hex encoding of as many whole bytes as fit in a buffer of
+  // maxLen characters, followed by a NUL terminator.  Returns the number of
+  // characters written, not including the terminator.
+  static size_t bytesToHexStr(
+    const uint8_t* bytes,
+    const size_t len,
+    char* buffer,
+    size_t maxLen,
+    const char* digits = HEX_DIGITS_UPPER
+  ) {
+    if (maxLen == 0) {
+      return 0;
+    }
+
+    size_t n = std::min(len, (maxLen - 1) / 2);
     char* p = buffer;
 
-    for (size_t i = 0; i < len && (p - buffer) < (maxLen - 2); i++) {
-      p += sprintf(p, "%02X", bytes[i]);
+    for (size_t i = 0; i < n; i++) {
+      *p++ = digits[bytes[i] >> 4];
+      *p++ = digits[bytes[i] & 0xF];
     }
+
+    *p = 0;
+
+    return p - buffer;
   }
 };
 
@@ -0,0 +1,32 @@
+#ifndef _RUNTIME_STATS_H
+#define _RUNTIME_STATS_H
+
+#include <Arduino.h>
+
+// Counters collected during boot and operation, reported on /about
+struct RuntimeStats {
+  RuntimeStats()
+    : wifiConnectMillis(0)
+    , wifiFastConnect(false)
+    , gatewayConnectionsOpened(0)
+    , gatewayRequestsSent(0)
+    , gatewayRequestsFailed(0)
+    , gatewayRequestsDropped(0)
+    , readingsNotBuffered(0)
+  { }
+
+  unsigned long wifiConnectMillis;
+  bool wifiFastConnect;
+
+  uint32_t gatewayConnectionsOpened;
+  uint32_t gatewayRequestsSent;
+  uint32_t gatewayRequestsFailed;
+  // Requests rejected because the queue was full
+  uint32_t gatewayRequestsDropped;
+
+  // Deep sleep readings that didn't fit in RTC memory's sensor table, since
+  // RTC memory was last reset
+  uint32_t readingsNotBuffered;
+};
+
+#endif
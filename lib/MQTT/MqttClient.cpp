@@ -1,6 +1,67 @@
 #include <stddef.h>
 #include <MqttClient.h>
 #include <WiFiClient.h>
+#include <algorithm>
+
+// Messages that fit in PubSubClient's buffer go out through publish() as a
+// single write.  Larger ones (the aggregate state document) are streamed with
+// beginPublish(), collected into chunks of at least one TCP segment so that
+// each write fills a segment rather than queueing small ones behind Nagle.
+#ifndef MQTT_WRITE_CHUNK_SIZE
+#define MQTT_WRITE_CHUNK_SIZE 1460
+#endif
+
+// Fixed header, plus the two byte topic length
+#define MQTT_PUBLISH_OVERHEAD (MQTT_MAX_HEADER_SIZE + 2)
+
+namespace {
+
+class ChunkedWriter : public Print {
+public:
+  // The buffer is only as large as the message needs, and lives on the heap
+  // to keep a full segment off the stack
+  ChunkedWriter(Print& out, size_t size)
+    : out(out),
+      capacity(std::max<size_t>(1, std::min<size_t>(size, MQTT_WRITE_CHUNK_SIZE))),
+      buffer(new uint8_t[capacity]),
+      length(0),
+      written(0)
+  { }
+
+  ~ChunkedWriter() {
+    delete[] buffer;
+  }
+
+  virtual size_t write(uint8_t c) {
+    buffer[length++] = c;
+
+    if (length == capacity) {
+      flush();
+    }
+
+    return 1;
+  }
+
+  void flush() {
+    if (length > 0) {
+      written += out.write(buffer, length);
+      length = 0;
+    }
+  }
+
+  size_t totalWritten() const {
+    return written;
+  }
+
+private:
+  Print& out;
+  size_t capacity;
+  uint8_t* buffer;
+  size_t length;
+  size_t written;
+};
+
+}
 
 MqttClient::MqttClient(Settings& settings)
   : settings(settings),
@@ -77,12 +138,27 @@ void MqttClient::handleClient() {
   mqttClient->loop();
 }
 
-void MqttClient::sendUpdate(const String& deviceName, const char* update) {
-  String topic = settings.mqttTopic;
-  topic += "/";
-  topic += deviceName;
+bool MqttClient::sendUpdate(const SensorRecord& sensor, const char* update) {
+  return publish(sensor.mqttTopic, update, true);
+}
+
+bool MqttClient::sendState(const JsonDocument& state) {
+  char topic[SENSOR_TOPIC_LENGTH + 1];
+  snprintf_P(topic, sizeof(topic), PSTR("%s/%s"), settings.mqttTopic.c_str(), MQTT_STATE_TOPIC_SUFFIX);
+
+  // Grows with the number of probes, so it's serialized straight to the
+  // connection instead of through a String
+  size_t length = measureJson(state);
+
+  if (! beginPublish(topic, length, true)) {
+    return false;
+  }
+
+  ChunkedWriter writer(*mqttClient, length);
+  serializeJson(state, writer);
+  writer.flush();
 
-  publish(topic, update, true);
+  return endPublish(topic, length, writer.totalWritten());
 }
 
 void MqttClient::subscribe() {
@@ -97,18 +173,58 @@ void MqttClient::subscribe() {
   mqttClient->subscribe(phonyTopic);
 }
 
-void MqttClient::publish(
-  const String& topic,
+bool MqttClient::beginPublish(const char* topic, size_t length, const bool retain) {
+#ifdef MQTT_DEBUG
+  printf("MqttClient - publishing %u bytes to %s\n", length, topic);
+#endif
+
+  if (! mqttClient->beginPublish(topic, length, retain)) {
+    Serial.printf_P(PSTR("ERROR: Failed to publish to %s (state %d)\n"), topic, mqttClient->state());
+    return false;
+  }
+
+  return true;
+}
+
+bool MqttClient::endPublish(const char* topic, size_t length, size_t written) {
+  if (! mqttClient->endPublish() || written != length) {
+    Serial.printf_P(PSTR("ERROR: Wrote %u of %u bytes to %s\n"), written, length, topic);
+    return false;
+  }
+
+  return true;
+}
+
+bool MqttClient::publish(
+  const char* topic,
   const char* message,
   const bool retain
 ) {
-  if (topic.length() == 0) {
-    return;
+  // Nothing to publish to; not a failure
+  if (strlen(topic) == 0) {
+    return true;
   }
 
+  size_t length = strlen(message);
+
+  if (MQTT_PUBLISH_OVERHEAD + strlen(topic) + length <= MQTT_MAX_PACKET_SIZE) {
 #ifdef MQTT_DEBUG
-  printf("MqttClient - publishing update to %s\n", topic.c_str());
+    printf("MqttClient - publishing %u bytes to %s\n", length, topic);
 #endif
 
-  mqttClient->publish(topic.c_str(), message, retain);
-}
\ No newline at end of file
+    if (! mqttClient->publish(topic, message, retain)) {
+      Serial.printf_P(PSTR("ERROR: Failed to publish to %s (state %d)\n"), topic, mqttClient->state());
+      return false;
+    }
+
+    return true;
+  }
+
+  if (! beginPublish(topic, length, retain)) {
+    return false;
+  }
+
+  size_t written = mqttClient->write(reinterpret_cast<const uint8_t*>(message), length);
+
+  return endPublish(topic, length, written);
+}
@@ -1,11 +1,15 @@
 #include <Settings.h>
+#include <SensorRegistry.h>
 #include <PubSubClient.h>
+#include <ArduinoJson.h>
 #include <WiFiClient.h>
 
 #ifndef MQTT_CONNECTION_ATTEMPT_FREQUENCY
 #define MQTT_CONNECTION_ATTEMPT_FREQUENCY 5000
 #endif
 
+#define MQTT_STATE_TOPIC_SUFFIX "state"
+
 #ifndef _MQTT_CLIENT_H
 #define _MQTT_CLIENT_H
 
@@ -17,7 +21,9 @@ public:
   void begin();
   void handleClient();
   void reconnect();
-  void sendUpdate(const String& deviceName, const char* update);
+  // Return false if the message couldn't be published
+  bool sendUpdate(const SensorRecord& sensor, const char* update);
+  bool sendState(const JsonDocument& state);
 
 private:
   WiFiClient tcpClient;
@@ -29,8 +35,10 @@ private:
   bool connect();
   void subscribe();
   void publishCallback(char* topic, byte* payload, int length);
-  void publish(
-    const String& topic,
+  bool beginPublish(const char* topic, size_t length, const bool retain);
+  bool endPublish(const char* topic, size_t length, size_t written);
+  bool publish(
+    const char* topic,
     const char* update,
     const bool retain = false
   );
@@ -0,0 +1,166 @@
+#include <RtcState.h>
+#include <Crc32.h>
+
+static_assert(sizeof(RtcData) <= RTC_USER_MEMORY_SIZE, "RTC state does not fit in RTC user memory");
+static_assert(sizeof(RtcData) % 4 == 0, "RTC state must be a multiple of 4 bytes");
+static_assert(RTC_READING_CAPACITY <= 255, "RTC reading indices are stored in a byte");
+static_assert(RTC_MAX_SENSORS <= 64, "RTC sensor indices are stored in 6 bits");
+
+#define READING_VOLTAGE_MASK 0x3FF
+#define READING_SENSOR_SHIFT 10
+
+RtcState::RtcState() {
+  reset();
+}
+
+bool RtcState::load() {
+  ESP.rtcUserMemoryRead(0, reinterpret_cast<uint32_t*>(&data), sizeof(data));
+
+  if (data.version != RTC_STATE_VERSION || data.crc != computeCrc()) {
+    Serial.println(F("[RTC] No valid state in RTC memory, resetting"));
+    reset();
+    return false;
+  }
+
+  return true;
+}
+
+void RtcState::save() {
+  data.crc = computeCrc();
+  ESP.rtcUserMemoryWrite(0, reinterpret_cast<uint32_t*>(&data), sizeof(data));
+}
+
+void RtcState::reset() {
+  memset(&data, 0, sizeof(data));
+  data.version = RTC_STATE_VERSION;
+}
+
+uint32_t RtcState::computeCrc() const {
+  const uint8_t* start = reinterpret_cast<const uint8_t*>(&data) + sizeof(data.crc);
+  return Crc32::compute(start, sizeof(data) - sizeof(data.crc));
+}
+
+int16_t RtcState::findSensor(const uint8_t* addr) const {
+  for (uint8_t i = 0; i < data.sensorCount; i++) {
+    if (memcmp(data.sensors[i].addr, addr, 8) == 0) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+bool RtcState::isSensorReferenced(uint8_t sensor) const {
+  for (uint8_t i = 0; i < data.count; i++) {
+    const RtcReading& reading = data.readings[(data.head + i) % RTC_READING_CAPACITY];
+
+    if ((reading.sensorAndVoltage >> READING_SENSOR_SHIFT) == sensor) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// The table keeps probes across uploads so their saved state survives.  When
+// it's full, a probe with no buffered readings makes room for the new one.
+int16_t RtcState::findOrAddSensor(const uint8_t* addr) {
+  int16_t ix = findSensor(addr);
+
+  if (ix >= 0) {
+    return ix;
+  }
+
+  if (data.sensorCount < RTC_MAX_SENSORS) {
+    ix = data.sensorCount++;
+  } else {
+    for (uint8_t i = 0; i < RTC_MAX_SENSORS && ix < 0; i++) {
+      if (! isSensorReferenced(i)) {
+        ix = i;
+      }
+    }
+
+    if (ix < 0) {
+      return -1;
+    }
+  }
+
+  memset(&data.sensors[ix], 0, sizeof(data.sensors[ix]));
+  memcpy(data.sensors[ix].addr, addr, 8);
+
+  return ix;
+}
+
+bool RtcState::append(const uint8_t* addr, float temperature, uint16_t voltage, time_t timestamp) {
+  int16_t sensor = findOrAddSensor(addr);
+
+  if (sensor < 0) {
+    if (data.readingsNotBuffered < UINT16_MAX) {
+      data.readingsNotBuffered++;
+    }
+
+    return false;
+  }
+
+  uint8_t ix = (data.head + data.count) % RTC_READING_CAPACITY;
+
+  if (data.count == RTC_READING_CAPACITY) {
+    // Full: drop the oldest reading
+    data.head = (data.head + 1) % RTC_READING_CAPACITY;
+  } else {
+    data.count++;
+  }
+
+  RtcReading& reading = data.readings[ix];
+  reading.timestamp = timestamp;
+  reading.temperature = lroundf(temperature * 100);
+  reading.sensorAndVoltage = (sensor << READING_SENSOR_SHIFT) | (voltage & READING_VOLTAGE_MASK);
+
+  return true;
+}
+
+bool RtcState::getReading(size_t i, uint8_t* addr, float& temperature, uint16_t& voltage, time_t& timestamp) const {
+  if (i >= data.count) {
+    return false;
+  }
+
+  const RtcReading& reading = data.readings[(data.head + i) % RTC_READING_CAPACITY];
+
+  memcpy(addr, data.sensors[reading.sensorAndVoltage >> READING_SENSOR_SHIFT].addr, 8);
+  temperature = reading.temperature / 100.0f;
+  voltage = reading.sensorAndVoltage & READING_VOLTAGE_MASK;
+  timestamp = reading.timestamp;
+
+  return true;
+}
+
+size_t RtcState::readingCount() const {
+  return data.count;
+}
+
+void RtcState::clearReadings() {
+  data.head = 0;
+  data.count = 0;
+  data.wakesSinceUpload = 0;
+}
+
+bool RtcState::saveProbe(const uint8_t* addr, const RtcProbeState& state) {
+  int16_t sensor = findOrAddSensor(addr);
+
+  if (sensor < 0) {
+    return false;
+  }
+
+  data.sensors[sensor].probe = state;
+  return true;
+}
+
+const RtcProbeState* RtcState::findProbe(const uint8_t* addr) const {
+  int16_t sensor = findSensor(addr);
+
+  if (sensor < 0 || data.sensors[sensor].probe.storedResolution == 0) {
+    return NULL;
+  }
+
+  return &data.sensors[sensor].probe;
+}
@@ -0,0 +1,131 @@
+#include <Arduino.h>
+#include <TimeLib.h>
+
+#ifndef _RTC_STATE_H
+#define _RTC_STATE_H
+
+// RTC user memory is 512 bytes and survives deep sleep and soft restarts (but
+// not power loss).  Everything below must fit in it.
+#define RTC_USER_MEMORY_SIZE 512
+#define RTC_STATE_VERSION 5
+
+#ifndef RTC_MAX_SENSORS
+#define RTC_MAX_SENSORS 16
+#endif
+
+#ifndef RTC_READING_CAPACITY
+#define RTC_READING_CAPACITY 32
+#endif
+
+// A single buffered sample.  Temperature is stored in hundredths of a degree F,
+// and the ADC voltage reading (10 bits) shares a word with the sensor index.
+struct RtcReading {
+  uint32_t timestamp;
+  int16_t temperature;
+  uint16_t sensorAndVoltage;
+};
+
+// Parameters of the last DHCP-negotiated connection, used to skip the scan and
+// DHCP exchange on the next wake.  uses == 0 means the cache is empty.
+struct RtcWifiCache {
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t uses;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+// Keeps wall-clock time across deep sleep so that wakes don't need NTP.
+struct RtcClock {
+  // Estimated UTC time at the next wake
+  uint32_t wakeEpoch;
+  // Duration of the sleep that ends at wakeEpoch
+  uint32_t sleepSeconds;
+  // Seconds spent on estimated time since the last NTP sync
+  uint32_t secondsSinceSync;
+  // Measured deep sleep timer error, applied as a correction on each wake
+  int32_t driftPpm;
+  uint16_t wakesSinceSync;
+  uint16_t reserved;
+};
+
+// Marks an RtcProbeState without a saved temperature
+#define RTC_NO_TEMPERATURE INT16_MIN
+
+// Adaptive resolution state of a probe, carried across deep sleep so that
+// successive wakes can keep lowering it.  storedResolution == 0 means nothing
+// was saved.
+struct RtcProbeState {
+  // Last reading, in hundredths of a degree F
+  int16_t temperature;
+  // Resolution in the probe's EEPROM
+  uint8_t storedResolution;
+  uint8_t adaptiveResolution;
+};
+
+struct RtcSensor {
+  uint8_t addr[8];
+  RtcProbeState probe;
+};
+
+struct RtcData {
+  uint32_t crc;
+  uint16_t version;
+  uint16_t wakesSinceUpload;
+
+  uint8_t head;
+  uint8_t count;
+  uint8_t sensorCount;
+  uint8_t nextWakeUploads;
+
+  // Readings turned away because every sensor slot was taken by a probe with
+  // buffered readings.  Kept until RTC memory is reset.
+  uint16_t readingsNotBuffered;
+  uint16_t reserved;
+
+  RtcClock clock;
+  RtcWifiCache wifi;
+
+  RtcSensor sensors[RTC_MAX_SENSORS];
+  RtcReading readings[RTC_READING_CAPACITY];
+};
+
+class RtcState {
+public:
+  RtcState();
+
+  // Returns false (and resets the state) if RTC memory didn't hold a valid image
+  bool load();
+  void save();
+  void reset();
+
+  // Appends a reading, overwriting the oldest one if the buffer is full.
+  // Returns false (and counts the reading in readingsNotBuffered) if there's
+  // no sensor slot for its probe, which can happen with more than
+  // RTC_MAX_SENSORS probes on the bus.
+  bool append(const uint8_t* addr, float temperature, uint16_t voltage, time_t timestamp);
+
+  // Reads the i'th buffered reading, oldest first
+  bool getReading(size_t i, uint8_t* addr, float& temperature, uint16_t& voltage, time_t& timestamp) const;
+
+  size_t readingCount() const;
+  void clearReadings();
+
+  // Probe state outlives the readings.  saveProbe() returns false if the sensor
+  // table has no room for the probe.
+  bool saveProbe(const uint8_t* addr, const RtcProbeState& state);
+  // NULL if no state was saved for the probe
+  const RtcProbeState* findProbe(const uint8_t* addr) const;
+
+  RtcData data;
+
+private:
+  int16_t findSensor(const uint8_t* addr) const;
+  int16_t findOrAddSensor(const uint8_t* addr);
+  bool isSensorReferenced(uint8_t sensor) const;
+  uint32_t computeCrc() const;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include <SensorRegistry.h>
+#include <IntParsing.h>
+#include <algorithm>
+
+SensorRegistry::SensorRegistry(Settings& settings)
+  : settings(settings)
+  , settingsGeneration(0)
+{ }
+
+uint64_t SensorRegistry::addressToRom(const uint8_t* address) {
+  uint64_t rom = 0;
+
+  // Big-endian, so that ROM order matches the order of the hex ids
+  for (size_t i = 0; i < 8; i++) {
+    rom = (rom << 8) | address[i];
+  }
+
+  return rom;
+}
+
+void SensorRegistry::romToAddress(uint64_t rom, uint8_t* address) {
+  for (int i = 7; i >= 0; i--) {
+    address[i] = rom & 0xFF;
+    rom >>= 8;
+  }
+}
+
+bool SensorRegistry::parseId(const char* id, uint64_t& rom) {
+  // A NUL before the end fails as an invalid digit, so this never reads past
+  // the end of a short id
+  return parseHex(id, SENSOR_ID_LENGTH, rom) && id[SENSOR_ID_LENGTH] == 0;
+}
+
+std::vector<SensorRecord>::iterator SensorRegistry::lowerBound(uint64_t rom) {
+  return std::lower_bound(
+    records.begin(),
+    records.end(),
+    rom,
+    [](const SensorRecord& record, uint64_t rom) { return record.rom < rom; }
+  );
+}
+
+const SensorRecord& SensorRegistry::add(const uint8_t* address) {
+  uint64_t rom = addressToRom(address);
+  std::vector<SensorRecord>::iterator itr = lowerBound(rom);
+
+  if (itr != records.end() && itr->rom == rom) {
+    return *itr;
+  }
+
+  SensorRecord record;
+  record.rom = rom;
+  IntParsing::bytesToHexStr(address, 8, record.id, sizeof(record.id));
+  resolve(record);
+
+  return *records.insert(itr, record);
+}
+
+const SensorRecord* SensorRegistry::find(uint64_t rom) {
+  std::vector<SensorRecord>::iterator itr = lowerBound(rom);
+
+  if (itr != records.end() && itr->rom == rom) {
+    return &(*itr);
+  }
+
+  return NULL;
+}
+
+const SensorRecord* SensorRegistry::find(const uint8_t* address) {
+  return find(addressToRom(address));
+}
+
+const SensorRecord* SensorRegistry::findById(const char* id) {
+  uint64_t rom;
+
+  if (parseId(id, rom)) {
+    return find(rom);
+  }
+
+  return NULL;
+}
+
+void SensorRegistry::refresh() {
+  if (settingsGeneration == settings.generation) {
+    return;
+  }
+
+  for (std::vector<SensorRecord>::iterator itr = records.begin(); itr != records.end(); ++itr) {
+    resolve(*itr);
+  }
+
+  settingsGeneration = settings.generation;
+}
+
+void SensorRegistry::resolve(SensorRecord& record) {
+  std::map<String, String>::iterator alias = settings.deviceAliases.find(record.id);
+  std::map<String, String>::iterator path = settings.sensorPaths.find(record.id);
+
+  record.hasAlias = alias != settings.deviceAliases.end();
+
+  // Settings::validate() keeps patched values within these buffers, so this
+  // only catches values from before the limits existed
+  bool truncated = strlcpy(record.name, record.hasAlias ? alias->second.c_str() : record.id, sizeof(record.name)) >= sizeof(record.name);
+  truncated |= snprintf_P(record.mqttTopic, sizeof(record.mqttTopic), PSTR("%s/%s"), settings.mqttTopic.c_str(), record.name) >= static_cast<int>(sizeof(record.mqttTopic));
+  truncated |= strlcpy(record.httpPath, path != settings.sensorPaths.end() ? path->second.c_str() : "", sizeof(record.httpPath)) >= sizeof(record.httpPath);
+
+  if (truncated) {
+    Serial.printf_P(PSTR("WARNING: Alias, MQTT topic or HTTP path for %s is too long and was truncated\n"), record.id);
+  }
+}
@@ -0,0 +1,57 @@
+#include <Arduino.h>
+#include <Settings.h>
+#include <vector>
+
+#ifndef _SENSOR_REGISTRY_H
+#define _SENSOR_REGISTRY_H
+
+#define SENSOR_ID_LENGTH 16
+#define SENSOR_NAME_LENGTH SETTINGS_MAX_ALIAS_LENGTH
+#define SENSOR_TOPIC_LENGTH (SETTINGS_MAX_TOPIC_PREFIX_LENGTH + 1 + SENSOR_NAME_LENGTH)
+#define SENSOR_PATH_LENGTH SETTINGS_MAX_SENSOR_PATH_LENGTH
+
+// Everything needed to publish a probe's readings, resolved once from settings
+// rather than on every update.
+struct SensorRecord {
+  uint64_t rom;
+  char id[SENSOR_ID_LENGTH + 1];
+  // Alias if one is configured, otherwise the id
+  char name[SENSOR_NAME_LENGTH + 1];
+  char mqttTopic[SENSOR_TOPIC_LENGTH + 1];
+  // Empty if no gateway path is configured for this sensor
+  char httpPath[SENSOR_PATH_LENGTH + 1];
+  bool hasAlias;
+};
+
+// Fixed-size records for every known probe, sorted by 64-bit ROM code.
+// Records are rebuilt when the settings generation changes.
+class SensorRegistry {
+public:
+  SensorRegistry(Settings& settings);
+
+  // Registers a probe.  Returns the existing record if it's already known.
+  const SensorRecord& add(const uint8_t* address);
+
+  const SensorRecord* find(uint64_t rom);
+  const SensorRecord* find(const uint8_t* address);
+  const SensorRecord* findById(const char* id);
+
+  // Re-resolves names, topics and paths if settings have changed
+  void refresh();
+
+  static uint64_t addressToRom(const uint8_t* address);
+  static void romToAddress(uint64_t rom, uint8_t* address);
+
+  // Parses a 16 character hex id.  Returns false if it isn't one.
+  static bool parseId(const char* id, uint64_t& rom);
+
+private:
+  Settings& settings;
+  std::vector<SensorRecord> records;
+  uint32_t settingsGeneration;
+
+  void resolve(SensorRecord& record);
+  std::vector<SensorRecord>::iterator lowerBound(uint64_t rom);
+};
+
+#endif
@@ -1,8 +1,10 @@
 #include <Settings.h>
 #include <IntParsing.h>
+#include <Crc32.h>
 
 #include <ArduinoJson.h>
 #include <FS.h>
+#include <algorithm>
 
 #define PORT_POSITION(s) ( s.indexOf(':') )
 
@@ -20,6 +22,105 @@ OperatingMode opModeFromString(const String& s) {
   return OperatingMode::DEEP_SLEEP;
 }
 
+struct SettingsImageHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t length;
+  uint32_t crc;
+};
+
+// Appends fields to the image.  Integers are stored at their native width and
+// strings are NUL-terminated.
+class SettingsImageWriter {
+public:
+  std::vector<uint8_t> buffer;
+
+  template <typename T>
+  void field(const T& value) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+  }
+
+  void field(const String& value) {
+    // Empty Strings may not have a buffer
+    if (value.length() > 0) {
+      const uint8_t* p = reinterpret_cast<const uint8_t*>(value.c_str());
+      buffer.insert(buffer.end(), p, p + value.length());
+    }
+
+    buffer.push_back(0);
+  }
+
+  template <typename V>
+  void field(const std::map<String, V>& values) {
+    field(static_cast<uint16_t>(values.size()));
+
+    for (typename std::map<String, V>::const_iterator itr = values.begin(); itr != values.end(); ++itr) {
+      field(itr->first);
+      field(itr->second);
+    }
+  }
+};
+
+// Reads fields back in the same order.  Fields past the end of an image
+// written by older firmware keep their current values.
+class SettingsImageReader {
+public:
+  SettingsImageReader(const uint8_t* data, size_t length)
+    : p(data)
+    , end(data + length)
+  { }
+
+  template <typename T>
+  void field(T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) {
+      p = end;
+      return;
+    }
+
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+  }
+
+  void field(String& value) {
+    const uint8_t* terminator = static_cast<const uint8_t*>(memchr(p, 0, end - p));
+
+    if (terminator == NULL) {
+      p = end;
+      return;
+    }
+
+    value = reinterpret_cast<const char*>(p);
+    p = terminator + 1;
+  }
+
+  template <typename V>
+  void field(std::map<String, V>& values) {
+    uint16_t count = 0;
+
+    if (p == end) {
+      return;
+    }
+
+    field(count);
+    values.clear();
+
+    for (uint16_t i = 0; i < count && p < end; i++) {
+      String key;
+      V value;
+
+      field(key);
+      field(value);
+      values[key] = value;
+    }
+  }
+
+private:
+  const uint8_t* p;
+  const uint8_t* end;
+};
+
 template <typename T>
 bool isDefined(const T& setting) {
   return setting != NULL && setting.length() > 0;
@@ -61,135 +162,427 @@ const String& Settings::getPassword() const {
   return adminPassword;
 }
 
-String Settings::deviceName(uint8_t* addr, bool resolveAlias) {
-  char deviceIdHex[50];
-  IntParsing::bytesToHexStr(addr, 8, deviceIdHex, sizeof(deviceIdHex) - 1);
+uint8_t Settings::deviceResolution(const String& deviceId) {
+  uint8_t resolution = sensorResolution;
+  std::map<String, uint8_t>::iterator itr = deviceResolutions.find(deviceId);
 
-  if (resolveAlias && deviceAliases.count(deviceIdHex) > 0) {
-    return deviceAliases[deviceIdHex];
-  } else {
-    return deviceIdHex;
+  if (itr != deviceResolutions.end()) {
+    resolution = itr->second;
   }
+
+  return constrain(resolution, MIN_SENSOR_RESOLUTION, MAX_SENSOR_RESOLUTION);
 }
 
-void Settings::deserialize(Settings& settings, String json) {
-  DynamicJsonDocument jsonBuffer(2048);
-  deserializeJson(jsonBuffer, json);
+void Settings::rebuildAliasIndex() {
+  aliasIndex.clear();
+  aliasIndex.reserve(deviceAliases.size());
+
+  for (std::map<String, String>::iterator itr = deviceAliases.begin(); itr != deviceAliases.end(); ++itr) {
+    AliasIndexEntry entry;
+    entry.alias = &itr->second;
+
+    // Keys that aren't full ROM ids can't name a sensor
+    if (itr->first.length() == sizeof(entry.rom) * 2
+      && parseHex(itr->first.c_str(), itr->first.length(), entry.rom)) {
+      aliasIndex.push_back(entry);
+    }
+  }
+
+  std::sort(
+    aliasIndex.begin(),
+    aliasIndex.end(),
+    [](const AliasIndexEntry& a, const AliasIndexEntry& b) { return strcmp(a.alias->c_str(), b.alias->c_str()) < 0; }
+  );
+}
+
+bool Settings::findAliasedDevice(const char* alias, uint64_t& rom) const {
+  std::vector<AliasIndexEntry>::const_iterator itr = std::lower_bound(
+    aliasIndex.begin(),
+    aliasIndex.end(),
+    alias,
+    [](const AliasIndexEntry& entry, const char* alias) { return strcmp(entry.alias->c_str(), alias) < 0; }
+  );
+
+  if (itr != aliasIndex.end() && strcmp(itr->alias->c_str(), alias) == 0) {
+    rom = itr->rom;
+    return true;
+  }
+
+  return false;
+}
+
+// Upper bound on the document capacity needed to parse a JSON stream of the
+// given size: every string is copied into the document, and each ':' starts at
+// most one member.  Rewinds the file to the start.
+static size_t jsonCapacityFor(File& file) {
+  size_t members = 0;
+  int c;
+
+  while ((c = file.read()) != -1) {
+    if (c == ':') {
+      members++;
+    }
+  }
+
+  file.seek(0);
+
+  return file.size() + JSON_OBJECT_SIZE(members) + JSON_OBJECT_SIZE(4);
+}
+
+// Strings are stored by reference when serializing.  Empty Strings may not
+// have a buffer, so point those at a literal.
+static const char* jsonString(const String& s) {
+  return s.length() > 0 ? s.c_str() : "";
+}
+
+void Settings::deserialize(Settings& settings, File& file) {
+  DynamicJsonDocument jsonBuffer(jsonCapacityFor(file));
+  DeserializationError error = deserializeJson(jsonBuffer, file);
   JsonObject parsedSettings = jsonBuffer.as<JsonObject>();
 
-  if (parsedSettings.isNull()) {
-    Serial.println(F("ERROR: could not parse settings file on flash"));
+  if (error || parsedSettings.isNull()) {
+    Serial.printf_P(PSTR("ERROR: could not parse settings file on flash: %s\n"), error.c_str());
   }
 
   settings.patch(parsedSettings);
 }
 
-void Settings::patch(JsonObject json) {
-  setIfPresent(json, "mqtt.server", _mqttServer);
-  setIfPresent(json, "mqtt.topic_prefix", mqttTopic);
-  setIfPresent(json, "mqtt.username", mqttUsername);
-  setIfPresent(json, "mqtt.password", mqttPassword);
+static bool checkLength(const char* key, const char* value, size_t maxLength, String& error) {
+  if (value != NULL && strlen(value) > maxLength) {
+    error = key;
+    error += F(" must be at most ");
+    error += maxLength;
+    error += F(" characters");
+    return false;
+  }
 
-  setIfPresent(json, "http.gateway_server", gatewayServer);
-  setIfPresent(json, "http.hmac_secret", hmacSecret);
+  return true;
+}
 
-  setIfPresent(json, "admin.web_ui_port", webPort);
-  setIfPresent(json, "admin.flag_server", flagServer);
-  setIfPresent(json, "admin.flag_server_port", flagServerPort);
-  setIfPresent(json, "admin.username", adminUsername);
-  setIfPresent(json, "admin.password", adminPassword);
-  setIfPresent(json, "thermometers.update_interval", updateInterval);
-  setIfPresent(json, "thermometers.poll_interval", sensorPollInterval);
-  setIfPresent(json, "thermometers.sensor_bus_pin", sensorBusPin);
+static bool checkLengths(JsonObject json, const char* key, size_t maxLength, String& error) {
+  JsonObject values = json[key].as<JsonObject>();
+
+  for (JsonObject::iterator itr = values.begin(); itr != values.end(); ++itr) {
+    if (! checkLength(key, itr->value().as<const char*>(), maxLength, error)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool Settings::validate(JsonObject json, String& error) {
+  return checkLength("mqtt.topic_prefix", json["mqtt.topic_prefix"].as<const char*>(), SETTINGS_MAX_TOPIC_PREFIX_LENGTH, error)
+    && checkLengths(json, "thermometers.aliases", SETTINGS_MAX_ALIAS_LENGTH, error)
+    && checkLengths(json, "http.sensor_paths", SETTINGS_MAX_SENSOR_PATH_LENGTH, error);
+}
+
+bool Settings::patch(JsonObject json) {
+  ChangedFields changed;
+  return patch(json, changed);
+}
+
+bool Settings::patch(JsonObject json, ChangedFields& changed) {
+  size_t previouslyChanged = changed.size();
+
+  setIfPresent(json, "mqtt.server", _mqttServer, changed);
+  setIfPresent(json, "mqtt.topic_prefix", mqttTopic, changed);
+  setIfPresent(json, "mqtt.username", mqttUsername, changed);
+  setSecretIfPresent(json, "mqtt.password", mqttPassword, changed);
+  setIfPresent(json, "mqtt.aggregate_state", mqttAggregateState, changed);
+  setIfPresent(json, "mqtt.per_sensor_topics", mqttPerSensorTopics, changed);
+
+  setIfPresent(json, "http.gateway_server", gatewayServer, changed);
+  setSecretIfPresent(json, "http.hmac_secret", hmacSecret, changed);
+  setIfPresent(json, "http.batch_path", batchPath, changed);
+
+  setIfPresent(json, "admin.web_ui_port", webPort, changed);
+  setIfPresent(json, "admin.flag_server", flagServer, changed);
+  setIfPresent(json, "admin.flag_server_port", flagServerPort, changed);
+  setIfPresent(json, "admin.flag_server_timeout", flagServerTimeout, changed);
+  setIfPresent(json, "admin.username", adminUsername, changed);
+  setSecretIfPresent(json, "admin.password", adminPassword, changed);
+  setIfPresent(json, "admin.ntp_sync_every", ntpSyncEvery, changed);
+  setIfPresent(json, "admin.max_clock_drift", maxClockDrift, changed);
+  setIfPresent(json, "thermometers.update_interval", updateInterval, changed);
+  setIfPresent(json, "thermometers.poll_interval", sensorPollInterval, changed);
+  setIfPresent(json, "thermometers.max_reading_age", maxReadingAge, changed);
+  setIfPresent(json, "thermometers.sensor_bus_pin", sensorBusPin, changed);
+  setIfPresent(json, "thermometers.resolution", sensorResolution, changed);
+  setIfPresent(json, "thermometers.adaptive_resolution", adaptiveResolution, changed);
+  setIfPresent(json, "thermometers.upload_every", uploadEvery, changed);
+  setIfPresent(json, "thermometers.batch_size", batchSize, changed);
 
   if (json.containsKey("admin.operating_mode")) {
-    opMode = opModeFromString(json["admin.operating_mode"]);
+    setIfChanged("admin.operating_mode", opMode, opModeFromString(json["admin.operating_mode"]), changed);
   }
 
   if (json.containsKey("thermometers.aliases")) {
     JsonObject aliases = json["thermometers.aliases"];
-    deviceAliases.clear();
+    std::map<String, String> value;
 
     for (JsonObject::iterator itr = aliases.begin(); itr != aliases.end(); ++itr) {
-      const char* value = itr->value().as<const char*>();
+      const char* alias = itr->value().as<const char*>();
 
-      if (strlen(value) > 0) {
-        deviceAliases[itr->key().c_str()] = value;
-      } else {
-        deviceAliases.erase(itr->key().c_str());
+      if (strlen(alias) > 0) {
+        value[itr->key().c_str()] = alias;
       }
     }
+
+    setIfChanged("thermometers.aliases", deviceAliases, value, changed);
+    rebuildAliasIndex();
+  }
+
+  if (json.containsKey("thermometers.resolutions")) {
+    JsonObject resolutions = json["thermometers.resolutions"];
+    std::map<String, uint8_t> value;
+
+    for (JsonObject::iterator itr = resolutions.begin(); itr != resolutions.end(); ++itr) {
+      uint8_t resolution = itr->value().as<uint8_t>();
+
+      if (resolution > 0) {
+        value[itr->key().c_str()] = resolution;
+      }
+    }
+
+    setIfChanged("thermometers.resolutions", deviceResolutions, value, changed);
   }
 
   if (json.containsKey("http.sensor_paths")) {
     JsonObject sensorPaths = json["http.sensor_paths"].as<JsonObject>();
-    this->sensorPaths.clear();
+    std::map<String, String> value;
 
     for (JsonObject::iterator itr = sensorPaths.begin(); itr != sensorPaths.end(); ++itr) {
-      const char* value = itr->value().as<const char*>();
+      const char* path = itr->value().as<const char*>();
 
-      if (strlen(value) > 0) {
-        this->sensorPaths[itr->key().c_str()] = value;
-      } else {
-        this->sensorPaths.erase(itr->key().c_str());
+      if (strlen(path) > 0) {
+        value[itr->key().c_str()] = path;
       }
     }
+
+    setIfChanged("http.sensor_paths", this->sensorPaths, value, changed);
+  }
+
+  if (changed.size() == previouslyChanged) {
+    return false;
+  }
+
+  generation++;
+  return true;
+}
+
+template <typename Archive>
+void Settings::visitFields(Archive& archive) {
+  archive.field(_mqttServer);
+  archive.field(mqttTopic);
+  archive.field(mqttUsername);
+  archive.field(mqttPassword);
+  archive.field(mqttAggregateState);
+  archive.field(mqttPerSensorTopics);
+
+  archive.field(gatewayServer);
+  archive.field(hmacSecret);
+  archive.field(batchPath);
+  archive.field(sensorPaths);
+
+  archive.field(webPort);
+  archive.field(flagServer);
+  archive.field(flagServerPort);
+  archive.field(flagServerTimeout);
+  archive.field(adminUsername);
+  archive.field(adminPassword);
+  archive.field(opMode);
+  archive.field(ntpSyncEvery);
+  archive.field(maxClockDrift);
+
+  archive.field(sensorBusPin);
+  archive.field(updateInterval);
+  archive.field(sensorPollInterval);
+  archive.field(maxReadingAge);
+  archive.field(sensorResolution);
+  archive.field(adaptiveResolution);
+  archive.field(uploadEvery);
+  archive.field(batchSize);
+  archive.field(deviceAliases);
+  archive.field(deviceResolutions);
+
+  archive.field(flashWrites);
+}
+
+bool Settings::loadImage(const char* path) {
+  if (! SPIFFS.exists(path)) {
+    return false;
+  }
+
+  // One read for the whole image
+  File f = SPIFFS.open(path, "r");
+  std::vector<uint8_t> buffer(f ? f.size() : 0);
+  size_t read = f ? f.read(buffer.data(), buffer.size()) : 0;
+  f.close();
+
+  SettingsImageHeader header;
+
+  if (read < sizeof(header) || read != buffer.size()) {
+    Serial.println(F("ERROR: could not read settings image"));
+    return false;
   }
+
+  memcpy(&header, buffer.data(), sizeof(header));
+  const uint8_t* payload = buffer.data() + sizeof(header);
+
+  if (header.magic != SETTINGS_IMAGE_MAGIC || header.version != SETTINGS_IMAGE_VERSION || header.length != read - sizeof(header)) {
+    Serial.println(F("ERROR: settings image has an unexpected format"));
+    return false;
+  }
+
+  if (Crc32::compute(payload, header.length) != header.crc) {
+    Serial.println(F("ERROR: settings image is corrupt"));
+    return false;
+  }
+
+  SettingsImageReader reader(payload, header.length);
+  visitFields(reader);
+
+  rebuildAliasIndex();
+  generation++;
+
+  return true;
 }
 
 void Settings::load(Settings& settings) {
+  if (settings.loadImage(SETTINGS_IMAGE_FILE)) {
+    return;
+  }
+
+  // A save was interrupted between removing the old image and renaming the
+  // new one into place
+  if (settings.loadImage(SETTINGS_IMAGE_TEMP_FILE)) {
+    Serial.println(F("Recovered settings from interrupted save"));
+    SPIFFS.rename(SETTINGS_IMAGE_TEMP_FILE, SETTINGS_IMAGE_FILE);
+    return;
+  }
+
   if (SPIFFS.exists(SETTINGS_FILE)) {
+    Serial.println(F("Migrating settings from " SETTINGS_FILE));
+
     File f = SPIFFS.open(SETTINGS_FILE, "r");
-    String settingsContents = f.readStringUntil(SETTINGS_TERMINATOR);
+    deserialize(settings, f);
     f.close();
 
-    deserialize(settings, settingsContents);
+    if (settings.save()) {
+      SPIFFS.remove(SETTINGS_FILE);
+    }
+  } else if (SPIFFS.exists(SETTINGS_IMAGE_FILE) || SPIFFS.exists(SETTINGS_IMAGE_TEMP_FILE)) {
+    // Corrupt, or written by newer firmware.  Leave it in place rather than
+    // replacing it with defaults, so that it survives a firmware downgrade and
+    // can be inspected.  It's only overwritten if settings are changed.
+    Serial.println(F("ERROR: settings image could not be loaded, running with defaults"));
   } else {
     settings.save();
   }
 }
 
-void Settings::save() {
-  File f = SPIFFS.open(SETTINGS_FILE, "w");
+bool Settings::save() {
+  unsigned long start = millis();
+  SettingsImageWriter writer;
+  SettingsImageHeader header;
+
+  flashWrites++;
+
+  writer.buffer.reserve(512);
+  visitFields(writer);
+
+  header.magic = SETTINGS_IMAGE_MAGIC;
+  header.version = SETTINGS_IMAGE_VERSION;
+  header.reserved = 0;
+  header.length = writer.buffer.size();
+  header.crc = Crc32::compute(writer.buffer.data(), writer.buffer.size());
+
+  // Write the new image alongside the old one so that a brownout mid-write
+  // leaves the previous settings intact
+  File f = SPIFFS.open(SETTINGS_IMAGE_TEMP_FILE, "w");
 
   if (!f) {
     Serial.println("Opening settings file failed");
-  } else {
-    serialize(f);
-    f.close();
+    return false;
+  }
+
+  bool ok = f.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header)
+    && f.write(writer.buffer.data(), writer.buffer.size()) == writer.buffer.size();
+  f.close();
+
+  // SPIFFS won't rename over an existing file
+  if (ok) {
+    SPIFFS.remove(SETTINGS_IMAGE_FILE);
+    ok = SPIFFS.rename(SETTINGS_IMAGE_TEMP_FILE, SETTINGS_IMAGE_FILE);
+  }
+
+  lastSaveDuration = millis() - start;
+
+  if (! ok) {
+    Serial.println(F("ERROR: failed to write settings image"));
   }
+
+  return ok;
 }
 
-void Settings::serialize(Stream& stream, const bool prettyPrint) {
-  DynamicJsonDocument jsonBuffer(2048);
+void Settings::serialize(Stream& stream, const bool prettyPrint, const bool redactSecrets) {
+  auto secret = [redactSecrets](const String& s) {
+    return redactSecrets && s.length() > 0 ? SETTINGS_REDACTED : jsonString(s);
+  };
+
+  // Values and keys reference the Strings held here rather than being copied,
+  // so the document only needs room for its members
+  DynamicJsonDocument jsonBuffer(
+    JSON_OBJECT_SIZE(SETTINGS_JSON_FIELDS)
+      + JSON_OBJECT_SIZE(deviceAliases.size())
+      + JSON_OBJECT_SIZE(deviceResolutions.size())
+      + JSON_OBJECT_SIZE(sensorPaths.size())
+  );
   JsonObject root = jsonBuffer.to<JsonObject>();
 
-  root["mqtt.server"] = this->_mqttServer;
-  root["mqtt.topic_prefix"] = this->mqttTopic;
-  root["mqtt.username"] = this->mqttUsername;
-  root["mqtt.password"] = this->mqttPassword;
+  root["mqtt.server"] = jsonString(this->_mqttServer);
+  root["mqtt.topic_prefix"] = jsonString(this->mqttTopic);
+  root["mqtt.username"] = jsonString(this->mqttUsername);
+  root["mqtt.password"] = secret(this->mqttPassword);
+  root["mqtt.aggregate_state"] = this->mqttAggregateState;
+  root["mqtt.per_sensor_topics"] = this->mqttPerSensorTopics;
 
-  root["http.gateway_server"] = this->gatewayServer;
-  root["http.hmac_secret"] = this->hmacSecret;
+  root["http.gateway_server"] = jsonString(this->gatewayServer);
+  root["http.hmac_secret"] = secret(this->hmacSecret);
+  root["http.batch_path"] = jsonString(this->batchPath);
 
   root["admin.web_ui_port"] = this->webPort;
-  root["admin.flag_server"] = this->flagServer;
+  root["admin.flag_server"] = jsonString(this->flagServer);
   root["admin.flag_server_port"] = this->flagServerPort;
-  root["admin.username"] = this->adminUsername;
-  root["admin.password"] = this->adminPassword;
+  root["admin.flag_server_timeout"] = this->flagServerTimeout;
+  root["admin.username"] = jsonString(this->adminUsername);
+  root["admin.password"] = secret(this->adminPassword);
   root["admin.operating_mode"] = OP_MODE_NAMES[static_cast<uint8_t>(this->opMode)];
+  root["admin.ntp_sync_every"] = this->ntpSyncEvery;
+  root["admin.max_clock_drift"] = this->maxClockDrift;
   root["thermometers.sensor_bus_pin"] = this->sensorBusPin;
   root["thermometers.update_interval"] = this->updateInterval;
   root["thermometers.poll_interval"] = this->sensorPollInterval;
+  root["thermometers.max_reading_age"] = this->maxReadingAge;
+  root["thermometers.resolution"] = this->sensorResolution;
+  root["thermometers.adaptive_resolution"] = this->adaptiveResolution;
+  root["thermometers.upload_every"] = this->uploadEvery;
+  root["thermometers.batch_size"] = this->batchSize;
 
   JsonObject aliases = root.createNestedObject("thermometers.aliases");
   for (std::map<String, String>::iterator itr = this->deviceAliases.begin(); itr != this->deviceAliases.end(); ++itr) {
-    aliases[itr->first] = itr->second;
+    aliases[itr->first.c_str()] = jsonString(itr->second);
+  }
+
+  JsonObject resolutions = root.createNestedObject("thermometers.resolutions");
+  for (std::map<String, uint8_t>::iterator itr = this->deviceResolutions.begin(); itr != this->deviceResolutions.end(); ++itr) {
+    resolutions[itr->first.c_str()] = itr->second;
   }
 
   JsonObject sensorPaths = root.createNestedObject("http.sensor_paths");
   for (std::map<String, String>::iterator itr = this->sensorPaths.begin(); itr != this->sensorPaths.end(); ++itr) {
-    sensorPaths[itr->first] = itr->second;
+    sensorPaths[itr->first.c_str()] = jsonString(itr->second);
   }
 
   if (prettyPrint) {
@@ -4,10 +4,28 @@
 #include <Time.h>
 #include <Timezone.h>
 #include <ArduinoJson.h>
+#include <FS.h>
 #include <map>
+#include <vector>
 
+// Legacy JSON settings file.  Migrated to the binary image on first boot.
 #define SETTINGS_FILE  "/config.json"
-#define SETTINGS_TERMINATOR '\0'
+
+// Stands in for secrets in serialized settings.  Patching a secret with this
+// value leaves it unchanged, so forms can round-trip redacted settings.
+#define SETTINGS_REDACTED "********"
+
+// Number of top-level members in the JSON representation, including the
+// nested alias, resolution and sensor path objects
+#define SETTINGS_JSON_FIELDS 29
+
+#define SETTINGS_IMAGE_FILE "/settings.bin"
+// Images are written here first and renamed over SETTINGS_IMAGE_FILE
+#define SETTINGS_IMAGE_TEMP_FILE "/settings.tmp"
+#define SETTINGS_IMAGE_MAGIC 0x53455454
+// Bump when the meaning or order of existing fields changes.  New fields can
+// be appended without a bump; older images leave them at their defaults.
+#define SETTINGS_IMAGE_VERSION 1
 
 #define XQUOTE(x) #x
 #define QUOTE(x) XQUOTE(x)
@@ -22,6 +40,18 @@
 
 #define DEFAULT_MQTT_PORT 1883
 
+#define MIN_SENSOR_RESOLUTION 9
+#define MAX_SENSOR_RESOLUTION 12
+
+// Longest values accepted for settings that are resolved into fixed-size
+// buffers for each sensor.  Topics are <topic_prefix>/<alias>.
+#define SETTINGS_MAX_ALIAS_LENGTH 32
+#define SETTINGS_MAX_TOPIC_PREFIX_LENGTH 63
+#define SETTINGS_MAX_SENSOR_PATH_LENGTH 64
+
+// Keys of the fields changed by a patch
+typedef std::vector<const char*> ChangedFields;
+
 enum class OperatingMode {
   DEEP_SLEEP = 0,
   ALWAYS_ON = 1
@@ -31,20 +61,39 @@ class Settings {
 public:
   Settings()
     : flagServerPort(31415)
+    , flagServerTimeout(1000)
+    , mqttAggregateState(false)
+    , mqttPerSensorTopics(true)
     , updateInterval(600)
     , sensorPollInterval(5)
+    , maxReadingAge(10)
     , webPort(80)
     , opMode(OperatingMode::DEEP_SLEEP)
     , sensorBusPin(2)
+    , sensorResolution(MAX_SENSOR_RESOLUTION)
+    , adaptiveResolution(false)
+    , uploadEvery(1)
+    , batchSize(0)
+    , ntpSyncEvery(24)
+    , maxClockDrift(30)
+    , generation(0)
+    , flashWrites(0)
+    , lastSaveDuration(0)
   { }
 
-  static void deserialize(Settings& settings, String json);
+  static void deserialize(Settings& settings, File& file);
   static void load(Settings& settings);
 
-  void save();
+  // Writes the binary settings image.  Returns false if it couldn't be written.
+  bool save();
   String toJson(const bool prettyPrint = true);
-  void serialize(Stream& stream, const bool prettyPrint = false);
-  void patch(JsonObject json);
+  void serialize(Stream& stream, const bool prettyPrint = false, const bool redactSecrets = false);
+  // Checks that values in a patch are within the limits above.  Returns false
+  // and describes the first problem in error if they aren't.
+  static bool validate(JsonObject json, String& error);
+  // Applies the given settings.  Returns true if any field changed.
+  bool patch(JsonObject json);
+  bool patch(JsonObject json, ChangedFields& changed);
 
   bool requiredSettingsDefined();
 
@@ -55,7 +104,13 @@ public:
   String mqttServer();
   uint16_t mqttPort();
 
-  String deviceName(uint8_t* addr, bool resolveDeviceName = true);
+  // Resolves an alias to the ROM code of the device it names.  Returns false
+  // if no device has that alias.
+  bool findAliasedDevice(const char* alias, uint64_t& rom) const;
+
+  // Configured resolution for a device: per-device override if present,
+  // otherwise the global setting.
+  uint8_t deviceResolution(const String& deviceId);
 
   String adminUsername;
   String adminPassword;
@@ -63,31 +118,109 @@ public:
 
   String gatewayServer;
   String hmacSecret;
+  // If set, all readings are sent to this path in a single request instead of
+  // one request per sensor path
+  String batchPath;
 
   String flagServer;
   uint16 flagServerPort;
+  // Deadline for the flag server to answer, in ms
+  uint16_t flagServerTimeout;
 
   unsigned long updateInterval;
   time_t sensorPollInterval;
+  time_t maxReadingAge;
   OperatingMode opMode;
 
   String _mqttServer;
   String mqttTopic;
   String mqttUsername;
   String mqttPassword;
+  // Publish all sensors as one JSON document to <topic_prefix>/state
+  bool mqttAggregateState;
+  bool mqttPerSensorTopics;
 
   uint8_t sensorBusPin;
+  uint8_t sensorResolution;
+  bool adaptiveResolution;
+
+  // Deep sleep batching: bring WiFi up every uploadEvery wakes, or sooner if
+  // more than batchSize readings are buffered (0 = as many as fit in RTC memory)
+  uint16_t uploadEvery;
+  uint16_t batchSize;
+
+  // Deep sleep wakes restore the clock from RTC memory, and only resync with
+  // NTP every ntpSyncEvery wakes or when estimated drift exceeds maxClockDrift
+  // seconds
+  uint16_t ntpSyncEvery;
+  uint16_t maxClockDrift;
 
   std::map<String, String> deviceAliases;
+  std::map<String, uint8_t> deviceResolutions;
   std::map<String, String> sensorPaths;
 
+  // Incremented whenever settings change so that derived state can tell when
+  // it's stale
+  uint32_t generation;
+
+  // Number of times settings have been written to flash, persisted in the
+  // image itself, and the duration of the last write in ms
+  uint32_t flashWrites;
+  unsigned long lastSaveDuration;
+
   template <typename T>
-  void setIfPresent(JsonObject obj, const char* key, T& var) {
+  void setIfPresent(JsonObject obj, const char* key, T& var, ChangedFields& changed) {
     if (obj.containsKey(key)) {
       JsonVariant val = obj[key];
-      var = val.as<T>();
+      setIfChanged(key, var, val.as<T>(), changed);
     }
   }
+
+  // Booleans submitted from the UI arrive as "true"/"false" strings
+  void setIfPresent(JsonObject obj, const char* key, bool& var, ChangedFields& changed) {
+    if (obj.containsKey(key)) {
+      JsonVariant val = obj[key];
+
+      if (val.is<const char*>()) {
+        setIfChanged(key, var, strcmp(val.as<const char*>(), "true") == 0, changed);
+      } else {
+        setIfChanged(key, var, val.as<bool>(), changed);
+      }
+    }
+  }
+
+  void setSecretIfPresent(JsonObject obj, const char* key, String& var, ChangedFields& changed) {
+    const char* value = obj[key].as<const char*>();
+
+    if (value == NULL || strcmp(value, SETTINGS_REDACTED) != 0) {
+      setIfPresent(obj, key, var, changed);
+    }
+  }
+
+  template <typename T>
+  void setIfChanged(const char* key, T& var, const T& value, ChangedFields& changed) {
+    if (! (var == value)) {
+      var = value;
+      changed.push_back(key);
+    }
+  }
+
+private:
+  struct AliasIndexEntry {
+    // Points into deviceAliases, so must be rebuilt whenever it changes
+    const String* alias;
+    uint64_t rom;
+  };
+
+  // deviceAliases sorted by alias
+  std::vector<AliasIndexEntry> aliasIndex;
+
+  void rebuildAliasIndex();
+  bool loadImage(const char* path);
+
+  // Visits every persisted field in image order
+  template <typename Archive>
+  void visitFields(Archive& archive);
 };
 
 #endif
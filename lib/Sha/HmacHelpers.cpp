@@ -1,27 +1,37 @@
-#include <inttypes.h>
-#include <sha1.h>
-#include <time.h>
+#include <HmacHelpers.h>
+#include <IntParsing.h>
+#include <stdio.h>
 
-String bin2hex(const uint8_t* bin, const int length) {
-  String hex = "";
+void bin2hex(const uint8_t* bin, size_t length, char* hex) {
+  IntParsing::bytesToHexStr(bin, length, hex, length * 2 + 1, HEX_DIGITS_LOWER);
+}
 
-  for (int i = 0; i < length; i++) {
-    if (bin[i] < 16) {
-      hex += "0";
-    }
-    hex += String(bin[i], HEX);
-  }
+RequestSigner::RequestSigner()
+  : keySet(false)
+{ }
 
-  return hex;
+void RequestSigner::setKey(const char* key, size_t keyLength) {
+  Sha1.prepareHmacKey(reinterpret_cast<const uint8_t*>(key), keyLength, this->key);
+  keySet = true;
 }
 
-String hmacDigest(String key, String message) {
-  Sha1.initHmac((uint8_t*)key.c_str(), key.length());
-  Sha1.print(message);
-  return bin2hex(Sha1.resultHmac(), HASH_LENGTH);
+bool RequestSigner::hasKey() const {
+  return keySet;
 }
 
-String requestSignature(String key, String path, String body, time_t timestamp) {
-  String payload = path + body + String(timestamp);
-  return hmacDigest(key, payload);
-}
\ No newline at end of file
+void RequestSigner::sign(
+  const char* path, size_t pathLength,
+  const char* body, size_t bodyLength,
+  time_t timestamp,
+  char* signature
+) {
+  char timestampStr[21];
+  int timestampLength = snprintf(timestampStr, sizeof(timestampStr), "%ld", static_cast<long>(timestamp));
+
+  Sha1.initHmac(key);
+  Sha1.write(reinterpret_cast<const uint8_t*>(path), pathLength);
+  Sha1.write(reinterpret_cast<const uint8_t*>(body), bodyLength);
+  Sha1.write(reinterpret_cast<const uint8_t*>(timestampStr), timestampLength);
+
+  bin2hex(Sha1.resultHmac(key), HASH_LENGTH, signature);
+}
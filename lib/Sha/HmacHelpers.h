@@ -1,5 +1,41 @@
 #include <sha1.h>
 #include <inttypes.h>
+#include <stddef.h>
+#include <time.h>
 
-String hmacDigest(String key, String message);
-String requestSignature(String key, String path, String body, time_t timestamp);
\ No newline at end of file
+#ifndef _HMAC_HELPERS_H
+#define _HMAC_HELPERS_H
+
+// Length of a hex encoded digest, not including the NUL terminator
+#define HMAC_HEX_LENGTH (HASH_LENGTH * 2)
+
+// Writes the lowercase hex encoding of bin and a NUL terminator to hex, which
+// must have room for 2 * length + 1 characters.
+void bin2hex(const uint8_t* bin, size_t length, char* hex);
+
+// Signs gateway requests with HMAC-SHA1 of the path, body and decimal
+// timestamp, concatenated.  The padded key is hashed once in setKey() and
+// reused for every request until the key changes.
+class RequestSigner {
+public:
+  RequestSigner();
+
+  void setKey(const char* key, size_t keyLength);
+  bool hasKey() const;
+
+  // The inputs are fed to the hash as they are, so nothing is copied or
+  // allocated.  Writes HMAC_HEX_LENGTH hex characters and a NUL terminator to
+  // signature.
+  void sign(
+    const char* path, size_t pathLength,
+    const char* body, size_t bodyLength,
+    time_t timestamp,
+    char* signature
+  );
+
+private:
+  Sha1HmacKey key;
+  bool keySet;
+};
+
+#endif
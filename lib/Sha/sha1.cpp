@@ -77,6 +77,37 @@ size_t Sha1Class::write(uint8_t data) {
   return 0;
 }
 
+size_t Sha1Class::write(const uint8_t* data, size_t length) {
+  size_t remaining = length;
+  uint8_t i;
+
+  byteCount += length;
+
+  // Top up a partially filled block
+  while (bufferOffset != 0 && remaining > 0) {
+    addUncounted(*data++);
+    remaining--;
+  }
+
+  // Whole blocks.  Words are assembled from bytes since data may not be word
+  // aligned, and unaligned loads fault on the ESP8266.
+  while (remaining >= BLOCK_LENGTH) {
+    for (i=0; i<BLOCK_LENGTH/4; i++) {
+      buffer.w[i] = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+      data += 4;
+    }
+    hashBlock();
+    remaining -= BLOCK_LENGTH;
+  }
+
+  while (remaining > 0) {
+    addUncounted(*data++);
+    remaining--;
+  }
+
+  return length;
+}
+
 void Sha1Class::pad() {
   // Implement SHA-1 padding (fips180-2 §5.1.1)
 
@@ -118,33 +149,60 @@ uint8_t* Sha1Class::result(void) {
 #define HMAC_IPAD 0x36
 #define HMAC_OPAD 0x5c
 
-void Sha1Class::initHmac(const uint8_t* key, int keyLength) {
+void Sha1Class::saveMidstate(Sha1Midstate& midstate) {
+  memcpy(midstate.state.b,state.b,HASH_LENGTH);
+  midstate.byteCount = byteCount;
+}
+
+void Sha1Class::restoreMidstate(const Sha1Midstate& midstate) {
+  memcpy(state.b,midstate.state.b,HASH_LENGTH);
+  byteCount = midstate.byteCount;
+  bufferOffset = 0;
+}
+
+void Sha1Class::prepareHmacKey(const uint8_t* secret, int secretLength, Sha1HmacKey& key) {
   uint8_t i;
+  uint8_t keyBuffer[BLOCK_LENGTH];
   memset(keyBuffer,0,BLOCK_LENGTH);
-  if (keyLength > BLOCK_LENGTH) {
+  if (secretLength > BLOCK_LENGTH) {
     // Hash long keys
     init();
-    for (;keyLength--;) write(*key++);
+    for (;secretLength--;) write(*secret++);
     memcpy(keyBuffer,result(),HASH_LENGTH);
   } else {
     // Block length keys are used as is
-    memcpy(keyBuffer,key,keyLength);
+    memcpy(keyBuffer,secret,secretLength);
   }
-  // Start inner hash
+  // Each pad fills exactly one block
   init();
-  for (i=0; i<BLOCK_LENGTH; i++) {
-    write(keyBuffer[i] ^ HMAC_IPAD);
-  }
+  for (i=0; i<BLOCK_LENGTH; i++) write(keyBuffer[i] ^ HMAC_IPAD);
+  saveMidstate(key.inner);
+  init();
+  for (i=0; i<BLOCK_LENGTH; i++) write(keyBuffer[i] ^ HMAC_OPAD);
+  saveMidstate(key.outer);
 }
 
-uint8_t* Sha1Class::resultHmac(void) {
+void Sha1Class::initHmac(const Sha1HmacKey& key) {
+  // Start inner hash
+  restoreMidstate(key.inner);
+}
+
+uint8_t* Sha1Class::resultHmac(const Sha1HmacKey& key) {
   uint8_t i;
   // Complete inner hash
   memcpy(innerHash,result(),HASH_LENGTH);
   // Calculate outer hash
-  init();
-  for (i=0; i<BLOCK_LENGTH; i++) write(keyBuffer[i] ^ HMAC_OPAD);
+  restoreMidstate(key.outer);
   for (i=0; i<HASH_LENGTH; i++) write(innerHash[i]);
   return result();
 }
+
+void Sha1Class::initHmac(const uint8_t* key, int keyLength) {
+  prepareHmacKey(key,keyLength,hmacKey);
+  initHmac(hmacKey);
+}
+
+uint8_t* Sha1Class::resultHmac(void) {
+  return resultHmac(hmacKey);
+}
 Sha1Class Sha1;
@@ -16,6 +16,19 @@ union _state {
   uint32_t w[HASH_LENGTH/4];
 };
 
+// Hash state at a block boundary, from which hashing can be resumed
+struct Sha1Midstate {
+  _state state;
+  uint32_t byteCount;
+};
+
+// Inner and outer hash states after absorbing the padded HMAC key.  Preparing
+// these once per key saves two block compressions per HMAC.
+struct Sha1HmacKey {
+  Sha1Midstate inner;
+  Sha1Midstate outer;
+};
+
 class Sha1Class : public Print
 {
   public:
@@ -23,7 +36,19 @@ class Sha1Class : public Print
     void initHmac(const uint8_t* secret, int secretLength);
     uint8_t* result(void);
     uint8_t* resultHmac(void);
+
+    // Only valid at a block boundary
+    void saveMidstate(Sha1Midstate& midstate);
+    void restoreMidstate(const Sha1Midstate& midstate);
+
+    void prepareHmacKey(const uint8_t* secret, int secretLength, Sha1HmacKey& key);
+    void initHmac(const Sha1HmacKey& key);
+    uint8_t* resultHmac(const Sha1HmacKey& key);
+
     virtual size_t write(uint8_t);
+    // Loads whole blocks straight into the message schedule instead of going
+    // through write(uint8_t) once per byte
+    virtual size_t write(const uint8_t* data, size_t length);
     using Print::write;
   private:
     void pad();
@@ -34,7 +59,7 @@ class Sha1Class : public Print
     uint8_t bufferOffset;
     _state state;
     uint32_t byteCount;
-    uint8_t keyBuffer[BLOCK_LENGTH];
+    Sha1HmacKey hmacKey;
     uint8_t innerHash[HASH_LENGTH];
     
 };
@@ -1,28 +1,94 @@
 #include <TempIface.h>
-#include <IntParsing.h>
+#include <limits.h>
+#include <algorithm>
 
-TempIface::TempIface(DallasTemperature*& sensors, Settings& settings)
-  : sensors(sensors),
+// DS18B20 function commands and scratchpad layout
+#define DS18B20_WRITE_SCRATCHPAD 0x4E
+#define DS18B20_RECALL_EEPROM 0xB8
+#define DS18S20_FAMILY_CODE 0x10
+#define SCRATCHPAD_HIGH_ALARM 2
+#define SCRATCHPAD_LOW_ALARM 3
+
+// Upper bound on waiting for a recall from EEPROM, which normally takes
+// microseconds
+#define RECALL_EEPROM_TIMEOUT 10
+
+static bool probeLess(const TempIface::Probe& probe, uint64_t rom) {
+  return probe.rom < rom;
+}
+
+TempIface::TempIface(OneWire*& oneWire, DallasTemperature*& sensors, Settings& settings, SensorRegistry& registry)
+  : oneWire(oneWire),
+    sensors(sensors),
     settings(settings),
-    lastUpdatedAt(0)
+    registry(registry),
+    lastUpdatedAt(0),
+    readDuration(0),
+    state(ConversionState::IDLE),
+    cycleStartedAt(0),
+    conversionStartedAt(0),
+    conversionWindow(0),
+    cursor(0),
+    settingsGeneration(0)
 { }
 
 TempIface::~TempIface() { }
 
 void TempIface::begin() {
 
-  char strAddr[50];
+  uint8_t addr[8];
+
+  // Conversions are collected by the state machine in loop() rather than
+  // waited on inside the library.
+  sensors->setWaitForConversion(false);
 
   Serial.printf_P(PSTR("[Thermometer Scan] Detected %d devices\n"), sensors->getDeviceCount());
 
+  probes.clear();
+  probes.reserve(sensors->getDeviceCount());
+
   for (size_t i = 0; i < sensors->getDeviceCount(); ++i) {
-    uint8_t* addr = new uint8_t[8];
     sensors->getAddress(addr, i);
-    IntParsing::bytesToHexStr(addr, 8, strAddr, sizeof(strAddr)-1);
+    const SensorRecord& sensor = registry.add(addr);
+
+    Serial.printf_P(PSTR("[Thermometer Scan] ... found thermometer with address: %s\n"), sensor.id);
+
+    Probe probe;
+    probe.rom = sensor.rom;
+    probe.temperature = TEMP_IFACE_NO_READING;
+    probe.capturedAt = 0;
+    probe.status = ProbeStatus::NO_READING;
+    probe.resolution = sensors->getResolution(addr);
+    // Adaptive mode may have lowered the scratchpad's resolution before the
+    // last deep sleep, so the stored one comes from restore() or a recall
+    // when the probe is first configured
+    probe.storedResolution = 0;
+    probe.configuredResolution = settings.deviceResolution(sensor.id);
+    probe.adaptiveResolution = probe.configuredResolution;
+
+    probes.insert(std::lower_bound(probes.begin(), probes.end(), probe.rom, probeLess), probe);
+  }
+
+  // Resolutions are brought in line with the settings at the start of the
+  // first cycle
+  settingsGeneration = settings.generation;
+
+}
+
+void TempIface::restore(uint64_t rom, float temperature, uint8_t storedResolution, uint8_t adaptiveResolution) {
+
+  std::vector<Probe>::iterator itr = std::lower_bound(probes.begin(), probes.end(), rom, probeLess);
+
+  if (itr == probes.end() || itr->rom != rom) {
+    return;
+  }
 
-    Serial.printf_P(PSTR("[Thermometer Scan] ... found thermometer with address: %s\n"), strAddr);
+  itr->storedResolution = storedResolution;
+  itr->adaptiveResolution = adaptiveResolution;
 
-    seenIds[strAddr] = addr;
+  if (temperature != TEMP_IFACE_NO_READING) {
+    itr->temperature = temperature;
+    itr->status = ProbeStatus::RESTORED;
   }
 
 }
@@ -31,34 +97,296 @@ void TempIface::loop() {
 
   time_t n = now();
 
-  if (n > (lastUpdatedAt + settings.sensorPollInterval)) {
-    for (std::map<String, uint8_t*>::iterator itr = seenIds.begin(); itr != seenIds.end(); ++itr) {
-      sensors->requestTemperaturesByAddress(itr->second);
-      lastTemps[itr->first] = sensors->getTempF(itr->second);
-    }
+  if (state == ConversionState::IDLE && n > (lastUpdatedAt + settings.sensorPollInterval)) {
+    requestConversion();
     lastUpdatedAt = n;
   }
 
+  step();
+
+}
+
+void TempIface::requestConversion() {
+
+  if (state != ConversionState::IDLE) {
+    return;
+  }
+
+  refreshConfiguredResolutions();
+
+  cycleStartedAt = millis();
+  cursor = 0;
+  state = ConversionState::CONFIGURING;
+
+}
+
+void TempIface::startConversion() {
+
+  uint8_t maxResolution = MIN_SENSOR_RESOLUTION;
+  for (std::vector<Probe>::iterator itr = probes.begin(); itr != probes.end(); ++itr) {
+    maxResolution = max(maxResolution, itr->resolution);
+  }
+
+  // Skip-ROM conversion: every probe on the bus converts in parallel, so the
+  // window is set by the highest resolution on the bus
+  sensors->requestTemperatures();
+
+  conversionStartedAt = millis();
+  conversionWindow = sensors->millisToWaitForConversion(maxResolution);
+  state = ConversionState::CONVERTING;
+
+}
+
+void TempIface::step() {
+
+  switch (state) {
+    case ConversionState::IDLE:
+      break;
+
+    case ConversionState::CONFIGURING:
+      // Resolution changes cost a scratchpad read and write (and an EEPROM
+      // copy when the configured value changes), so they're spread across
+      // steps one probe at a time, like reads
+      if (cursor < probes.size()) {
+        configureProbe(probes[cursor]);
+        ++cursor;
+      }
+
+      if (cursor >= probes.size()) {
+        startConversion();
+      }
+      break;
+
+    case ConversionState::CONVERTING:
+      if ((millis() - conversionStartedAt) >= conversionWindow) {
+        cursor = 0;
+        state = ConversionState::READING;
+      }
+      break;
+
+    case ConversionState::READING:
+      // One scratchpad read per step keeps each call to a few milliseconds
+      if (cursor < probes.size()) {
+        Probe& probe = probes[cursor];
+        bool hadReading = probe.status == ProbeStatus::OK || probe.status == ProbeStatus::RESTORED;
+        float previous = probe.temperature;
+        uint8_t addr[8];
+
+        SensorRegistry::romToAddress(probe.rom, addr);
+        probe.temperature = sensors->getTempF(addr);
+        probe.capturedAt = millis();
+        probe.status = probe.temperature == DEVICE_DISCONNECTED_F ? ProbeStatus::DISCONNECTED : ProbeStatus::OK;
+
+        if (hadReading && settings.adaptiveResolution) {
+          adaptResolution(probe, previous, probe.temperature);
+        }
+
+        ++cursor;
+      }
+
+      if (cursor >= probes.size()) {
+        readDuration = millis() - cycleStartedAt;
+        state = ConversionState::IDLE;
+      }
+      break;
+  }
+
+}
+
+bool TempIface::isIdle() const {
+
+  return state == ConversionState::IDLE;
+
+}
+
+void TempIface::readAll() {
+
+  // A cycle already in flight (e.g. the one loop() starts on wake) produces
+  // fresh readings, so finish it rather than paying for a second conversion
+  if (isIdle()) {
+    requestConversion();
+  }
+
+  while (! isIdle()) {
+    step();
+    yield();
+  }
+
+}
+
+size_t TempIface::probeCount() const {
+
+  return probes.size();
+
+}
+
+const TempIface::Probe& TempIface::probe(size_t i) const {
+
+  return probes[i];
+
+}
+
+const TempIface::Probe* TempIface::find(uint64_t rom) const {
+
+  std::vector<Probe>::const_iterator itr = std::lower_bound(probes.begin(), probes.end(), rom, probeLess);
+
+  if (itr != probes.end() && itr->rom == rom) {
+    return &(*itr);
+  }
+
+  return NULL;
+
+}
+
+const bool TempIface::hasFreshReadings(unsigned long maxAge) const {
+
+  if (probes.empty()) {
+    return false;
+  }
+
+  unsigned long n = millis();
+
+  for (std::vector<Probe>::const_iterator itr = probes.begin(); itr != probes.end(); ++itr) {
+    if (itr->status == ProbeStatus::NO_READING
+      || itr->status == ProbeStatus::RESTORED
+      || (n - itr->capturedAt) > maxAge) {
+      return false;
+    }
+  }
+
+  return true;
+
 }
 
-const std::map<String, uint8_t*>& TempIface::thermometerIds() {
+const unsigned long TempIface::lastReadDuration() const {
 
-  return seenIds;
+  return readDuration;
 
 }
 
-const float TempIface::lastSeenTemp(const String& id) {
+uint8_t TempIface::targetResolution(const Probe& probe) const {
 
-  if (hasSeenId(id)) {
-    return lastTemps[id];
+  if (settings.adaptiveResolution) {
+    return min(probe.configuredResolution, probe.adaptiveResolution);
   } else {
-    return -187;
+    return probe.configuredResolution;
+  }
+
+}
+
+void TempIface::refreshConfiguredResolutions() {
+
+  if (settingsGeneration == settings.generation) {
+    return;
   }
 
+  for (std::vector<Probe>::iterator itr = probes.begin(); itr != probes.end(); ++itr) {
+    itr->configuredResolution = settings.deviceResolution(registry.find(itr->rom)->id);
+  }
+
+  settingsGeneration = settings.generation;
+
 }
 
-const bool TempIface::hasSeenId(const String& id) {
+void TempIface::configureProbe(Probe& probe) {
+
+  const SensorRecord* sensor = registry.find(probe.rom);
+  uint8_t target = targetResolution(probe);
+  uint8_t addr[8];
+  SensorRegistry::romToAddress(probe.rom, addr);
 
-  return lastTemps.count(id) > 0;
+  // Nothing was restored, so read the stored resolution back from EEPROM.
+  // This also resets the scratchpad to it.
+  if (probe.storedResolution == 0) {
+    recallStoredResolution(addr);
+    probe.resolution = probe.storedResolution = sensors->getResolution(addr);
+  }
+
+  // The library's setResolution() copies the scratchpad to EEPROM, which
+  // blocks for 20ms and wears the EEPROM.  Only do that when the configured
+  // resolution changes.
+  if (probe.storedResolution != probe.configuredResolution) {
+    Serial.printf_P(PSTR("[Thermometer] Storing resolution of %s as %u bits\n"), sensor->id, probe.configuredResolution);
 
-}
\ No newline at end of file
+    if (sensors->setResolution(addr, probe.configuredResolution, true)) {
+      probe.resolution = probe.storedResolution = probe.configuredResolution;
+    }
+  }
+
+  // Adaptive changes only go to the scratchpad
+  if (probe.resolution != target) {
+    Serial.printf_P(PSTR("[Thermometer] Setting resolution of %s to %u bits\n"), sensor->id, target);
+
+    if (writeResolution(addr, target)) {
+      probe.resolution = target;
+    }
+  }
+
+}
+
+// Writes the resolution to the probe's scratchpad without copying it to
+// EEPROM.  The alarm bytes share the write, so they're read back first and
+// preserved.
+bool TempIface::writeResolution(const uint8_t* addr, uint8_t resolution) {
+
+  DallasTemperature::ScratchPad scratchPad;
+
+  // DS18S20s have a fixed resolution
+  if (addr[0] == DS18S20_FAMILY_CODE || ! sensors->isConnected(addr, scratchPad)) {
+    return false;
+  }
+
+  oneWire->reset();
+  oneWire->select(addr);
+  oneWire->write(DS18B20_WRITE_SCRATCHPAD);
+  oneWire->write(scratchPad[SCRATCHPAD_HIGH_ALARM]);
+  oneWire->write(scratchPad[SCRATCHPAD_LOW_ALARM]);
+  // Configuration register: R1 R0 in bits 6 and 5, the rest are ones
+  oneWire->write(((resolution - MIN_SENSOR_RESOLUTION) << 5) | 0x1F);
+  oneWire->reset();
+
+  return true;
+
+}
+
+// Reloads the scratchpad's configuration and alarm bytes from EEPROM.
+void TempIface::recallStoredResolution(const uint8_t* addr) {
+
+  oneWire->reset();
+  oneWire->select(addr);
+  oneWire->write(DS18B20_RECALL_EEPROM);
+
+  // The probe holds the bus low until the recall is done.  Parasite powered
+  // probes can't signal, so just wait out the timeout.
+  unsigned long start = millis();
+  while ((millis() - start) < RECALL_EEPROM_TIMEOUT) {
+    if (! sensors->isParasitePowerMode() && oneWire->read_bit()) {
+      break;
+    }
+  }
+
+}
+
+void TempIface::adaptResolution(Probe& probe, float previous, float current) {
+
+  if (previous == DEVICE_DISCONNECTED_F || current == DEVICE_DISCONNECTED_F) {
+    return;
+  }
+
+  uint8_t configured = probe.configuredResolution;
+  uint8_t adaptive = min(probe.adaptiveResolution, configured);
+
+  // Size of one LSB at the current resolution: 0.0625C at 12 bits, doubling
+  // for each bit dropped
+  float step = (0.0625f * 1.8f) * (1 << (MAX_SENSOR_RESOLUTION - adaptive));
+  float delta = fabs(current - previous);
+
+  if (delta >= (ADAPTIVE_RESOLUTION_RAISE_STEPS * step)) {
+    adaptive = configured;
+  } else if (delta < step && adaptive > MIN_SENSOR_RESOLUTION) {
+    adaptive--;
+  }
+
+  probe.adaptiveResolution = adaptive;
+
+}
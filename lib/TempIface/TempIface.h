@@ -1,31 +1,115 @@
+#include <OneWire.h>
 #include <DallasTemperature.h>
 #include <Settings.h>
-#include <map>
+#include <SensorRegistry.h>
+#include <vector>
 
 #ifndef _TEMP_IFACE_H
 #define _TEMP_IFACE_H
 
+// In adaptive mode, resolution is raised back to the configured value when a
+// reading moves by at least this many steps of the current resolution.
+#ifndef ADAPTIVE_RESOLUTION_RAISE_STEPS
+#define ADAPTIVE_RESOLUTION_RAISE_STEPS 2
+#endif
+
+// Reported for probes that haven't been read yet
+#define TEMP_IFACE_NO_READING -187
+
 class TempIface {
 public:
 
-  TempIface(DallasTemperature*& sensors, Settings& settings);
+  enum class ConversionState { IDLE, CONFIGURING, CONVERTING, READING };
+
+  // RESTORED readings were carried over from before deep sleep.  They're only
+  // a baseline for adaptive resolution, and never count as fresh.
+  enum class ProbeStatus : uint8_t { NO_READING, OK, DISCONNECTED, RESTORED };
+
+  // Everything tracked for one probe on the bus
+  struct Probe {
+    uint64_t rom;
+    float temperature;
+    unsigned long capturedAt;
+    ProbeStatus status;
+    // Resolution currently programmed into the probe's scratchpad, the one in
+    // its EEPROM (applied at power-up, 0 until known), the configured value,
+    // and the adaptive target
+    uint8_t resolution;
+    uint8_t storedResolution;
+    uint8_t configuredResolution;
+    uint8_t adaptiveResolution;
+  };
+
+  TempIface(OneWire*& oneWire, DallasTemperature*& sensors, Settings& settings, SensorRegistry& registry);
   ~TempIface();
 
   void begin();
+
+  // Restores state saved before deep sleep, sparing the EEPROM recall and
+  // letting adaptive resolution carry on from the last reading.  Call after
+  // begin(); ignored for probes that weren't detected.
+  void restore(uint64_t rom, float temperature, uint8_t storedResolution, uint8_t adaptiveResolution);
+
+  // Advances the conversion state machine.  Never waits on the bus: starts a
+  // cycle when a poll is due, brings one probe's resolution up to date per
+  // call, converts, and reads back one probe per call once the conversion
+  // window has elapsed.
   void loop();
-  const std::map<String, uint8_t*>& thermometerIds();
-  const float lastSeenTemp(const String& id);
-  const bool hasSeenId(const String& id);
+
+  // Starts a cycle (resolution updates, then a bus-wide conversion) if one
+  // isn't already in progress.
+  void requestConversion();
+  bool isIdle() const;
+
+  // Blocking variant: issues a single Skip-ROM "convert T" for the whole bus,
+  // then reads each probe's scratchpad.  Costs one conversion time regardless
+  // of probe count.  If a conversion is already in progress, waits for that
+  // one instead of starting another.
+  void readAll();
+
+  // Detected probes, sorted by ROM code
+  size_t probeCount() const;
+  const Probe& probe(size_t i) const;
+
+  // NULL if the probe wasn't detected
+  const Probe* find(uint64_t rom) const;
+
+  // True if every detected probe has a cached reading younger than maxAge ms
+  const bool hasFreshReadings(unsigned long maxAge) const;
+
+  // Duration of the last sensor phase (conversion + scratchpad reads), in ms
+  const unsigned long lastReadDuration() const;
 
 private:
 
-  std::map<String, uint8_t*> seenIds;
-  std::map<String, float> lastTemps;
+  std::vector<Probe> probes;
   time_t lastUpdatedAt;
+  unsigned long readDuration;
+
+  ConversionState state;
+  unsigned long cycleStartedAt;
+  unsigned long conversionStartedAt;
+  unsigned long conversionWindow;
+  // Next probe to configure or read
+  size_t cursor;
 
+  // Settings generation the configured resolutions were resolved against
+  uint32_t settingsGeneration;
+
+  OneWire*& oneWire;
   DallasTemperature*& sensors;
   Settings& settings;
+  SensorRegistry& registry;
+
+  void step();
+  void startConversion();
+  void refreshConfiguredResolutions();
+  void configureProbe(Probe& probe);
+  bool writeResolution(const uint8_t* addr, uint8_t resolution);
+  void recallStoredResolution(const uint8_t* addr);
+  uint8_t targetResolution(const Probe& probe) const;
+  void adaptResolution(Probe& probe, float previous, float current);
 
 };
 
-#endif // _TEMP_IFACE_H
\ No newline at end of file
+#endif // _TEMP_IFACE_H
@@ -0,0 +1,274 @@
+// Generated by .build_web.py from the files in web/.  Do not edit.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pgmspace.h>
+
+#ifndef _WEB_ASSETS_H
+#define _WEB_ASSETS_H
+
+// A gzipped asset and the headers to serve it with
+struct WebAsset {
+  const uint8_t* data;
+  size_t length;
+  const char* contentType;
+  const char* etag;
+  const char* cacheControl;
+};
+
+// index.html: 2979 bytes, 808 gzipped
+const uint8_t INDEX_PAGE_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xad, 0x56, 0xcd, 0x6e, 0xdb, 0x30,
+  0x0c, 0x7e, 0x15, 0x55, 0x3b, 0xec, 0x52, 0xc7, 0x49, 0xb3, 0xf5, 0x07, 0xb0, 0x3d, 0x74, 0x1b,
+  0x06, 0xec, 0xb0, 0xcb, 0xba, 0x3e, 0x00, 0x6d, 0xd1, 0xb1, 0x56, 0x59, 0x32, 0x24, 0x39, 0x41,
+  0xde, 0x7e, 0x94, 0x6c, 0xa7, 0x71, 0x87, 0x60, 0x45, 0xd6, 0x43, 0x55, 0x4b, 0xa4, 0x3e, 0xfe,
+  0x7d, 0xa4, 0x92, 0x5d, 0x08, 0x53, 0xf9, 0x7d, 0x87, 0xac, 0xf1, 0xad, 0x2a, 0xb2, 0xb0, 0x32,
+  0x05, 0x7a, 0x93, 0x73, 0xd4, 0x9c, 0xf6, 0x08, 0xa2, 0xc8, 0x5a, 0xf4, 0xc0, 0xaa, 0x06, 0xac,
+  0x43, 0x9f, 0xf3, 0xde, 0xd7, 0xc9, 0x2d, 0x1f, 0x4f, 0x35, 0xb4, 0x98, 0xf3, 0xad, 0xc4, 0x5d,
+  0x67, 0xac, 0xe7, 0xac, 0x32, 0xda, 0xa3, 0x26, 0xad, 0x9d, 0x14, 0xbe, 0xc9, 0x05, 0x6e, 0x65,
+  0x85, 0x49, 0xdc, 0x5c, 0x32, 0xa9, 0xa5, 0x97, 0xa0, 0x12, 0x57, 0x81, 0xc2, 0x7c, 0xb5, 0x58,
+  0x12, 0x8a, 0x97, 0x5e, 0x61, 0xf1, 0xab, 0x41, 0xdb, 0x1a, 0x42, 0x44, 0x9b, 0xa5, 0xc3, 0x51,
+  0xa6, 0xa4, 0x7e, 0x62, 0x16, 0x55, 0xce, 0x9d, 0xdf, 0x2b, 0x74, 0x0d, 0x22, 0x19, 0x68, 0x2c,
+  0xd6, 0x39, 0x4f, 0xe3, 0xd1, 0xa2, 0x72, 0xee, 0xd3, 0x36, 0xbf, 0xfe, 0x58, 0x96, 0x37, 0xcb,
+  0x9b, 0xeb, 0xf5, 0xd5, 0xf2, 0xfa, 0xea, 0xe3, 0xdd, 0x92, 0xa7, 0x45, 0xe6, 0x2a, 0x2b, 0x3b,
+  0xcf, 0x9c, 0xad, 0x82, 0x72, 0xdc, 0x2c, 0x7e, 0x07, 0xe5, 0xba, 0xc6, 0x0f, 0xcb, 0xe5, 0xdd,
+  0xea, 0x76, 0x85, 0x37, 0xeb, 0x5b, 0x01, 0x9c, 0x09, 0xac, 0xd1, 0x16, 0xd9, 0xa8, 0x45, 0x1f,
+  0x43, 0xd0, 0xa5, 0x11, 0xfb, 0x22, 0xd3, 0xb0, 0x65, 0x95, 0x02, 0xe7, 0x72, 0x4e, 0x9f, 0x25,
+  0x58, 0x72, 0x59, 0xc8, 0xc3, 0x59, 0x08, 0x17, 0xa4, 0xc6, 0x70, 0x0c, 0x93, 0x6f, 0x7c, 0x7e,
+  0x23, 0x29, 0x2d, 0x68, 0xc1, 0xe7, 0x31, 0xc2, 0xb3, 0xfe, 0x3b, 0x02, 0xa9, 0xe5, 0xa6, 0xb7,
+  0xc8, 0x8b, 0x2f, 0xd3, 0xe7, 0x5c, 0xc3, 0x63, 0xdb, 0xa1, 0x05, 0x4f, 0x02, 0x47, 0x40, 0x47,
+  0xbb, 0xb9, 0x1e, 0x88, 0x56, 0x52, 0xd9, 0xee, 0xc3, 0xbf, 0x28, 0x49, 0xc9, 0x57, 0x5a, 0xc9,
+  0x91, 0xc1, 0x6d, 0x29, 0x72, 0x5e, 0x82, 0x0e, 0x0e, 0x4f, 0x4e, 0x52, 0x29, 0xac, 0x67, 0x8d,
+  0x14, 0x22, 0x56, 0x7c, 0xb8, 0x71, 0x22, 0x44, 0x87, 0x95, 0x97, 0x46, 0x4f, 0x22, 0xff, 0x1c,
+  0x51, 0x32, 0x8a, 0x78, 0x34, 0x71, 0x14, 0x51, 0xd6, 0xac, 0x8e, 0xa3, 0xa2, 0xdd, 0x31, 0xb8,
+  0x35, 0xbb, 0x97, 0x09, 0x55, 0xf3, 0x83, 0x1d, 0xaa, 0x70, 0x52, 0x1b, 0xdb, 0x32, 0x88, 0x26,
+  0x42, 0x41, 0xd1, 0x7b, 0xa9, 0x37, 0x8e, 0x33, 0x32, 0xde, 0x18, 0xb2, 0xd8, 0xf5, 0x7e, 0x30,
+  0x3d, 0x89, 0x92, 0x70, 0x83, 0x2e, 0x96, 0xbd, 0xf7, 0xe4, 0x71, 0xe0, 0x38, 0x09, 0xfb, 0xb2,
+  0x95, 0xfe, 0x10, 0x7a, 0xe9, 0x35, 0xa3, 0xbf, 0xa4, 0xb3, 0xb2, 0x05, 0xbb, 0xe7, 0xc5, 0x43,
+  0x94, 0x67, 0xe9, 0x70, 0x89, 0x92, 0x11, 0x40, 0x0e, 0x59, 0xfc, 0x3b, 0x33, 0xff, 0xe9, 0x2b,
+  0x28, 0x09, 0x0e, 0x0f, 0xae, 0x36, 0xeb, 0x03, 0x32, 0x78, 0xdc, 0x18, 0xbb, 0x4f, 0x62, 0x2b,
+  0xf0, 0xe2, 0x6b, 0x6c, 0x23, 0x76, 0x3f, 0xe8, 0x53, 0x16, 0xd7, 0x64, 0x45, 0xa2, 0x12, 0x04,
+  0x3e, 0xdd, 0x09, 0x20, 0xc9, 0xc6, 0x9a, 0xbe, 0x0b, 0x55, 0x9c, 0xa4, 0x6f, 0x9f, 0x80, 0x71,
+  0x1d, 0xeb, 0xfd, 0x7a, 0x4e, 0xcc, 0x39, 0x1c, 0x68, 0x31, 0xe7, 0xf1, 0x79, 0xcc, 0x18, 0xe8,
+  0xd6, 0x5b, 0x4b, 0x43, 0x27, 0x79, 0x61, 0xe2, 0x2d, 0xbc, 0x1e, 0x3b, 0x2a, 0xb8, 0x3b, 0x76,
+  0xd5, 0xb9, 0x0c, 0x3e, 0x5d, 0xdd, 0x6f, 0xd2, 0xb6, 0x3b, 0xb0, 0xc8, 0x1e, 0xbb, 0x8d, 0x05,
+  0x81, 0x43, 0x7d, 0x8f, 0x10, 0x86, 0x16, 0x8d, 0x6b, 0x22, 0x75, 0x6d, 0x08, 0xad, 0xa3, 0xc2,
+  0x16, 0x3f, 0xe0, 0x09, 0x99, 0xa3, 0x68, 0x19, 0xf9, 0xcf, 0x4a, 0xa9, 0xa9, 0x86, 0x6c, 0x6f,
+  0xfa, 0xf7, 0x74, 0xd2, 0x77, 0xca, 0x80, 0x20, 0xe2, 0xb1, 0x1d, 0x38, 0x1a, 0xcb, 0x6d, 0x27,
+  0x15, 0x0a, 0x46, 0xf5, 0x0c, 0x1a, 0x96, 0x95, 0x06, 0xac, 0xb8, 0xa0, 0x4a, 0x17, 0xec, 0x60,
+  0x7f, 0x27, 0x7d, 0x43, 0x43, 0x3a, 0x28, 0x83, 0x97, 0xa5, 0x22, 0xf0, 0x91, 0xbc, 0x04, 0xd0,
+  0x2b, 0xc1, 0x3a, 0x8b, 0x5b, 0x4a, 0x34, 0x5d, 0x36, 0xde, 0x2d, 0xd8, 0xf7, 0x9a, 0x0c, 0x4b,
+  0xc7, 0x1a, 0xe8, 0x3a, 0xd4, 0xee, 0x92, 0xa6, 0x75, 0x4d, 0x1e, 0x37, 0x83, 0x3b, 0xc1, 0xc0,
+  0x00, 0xf9, 0xf8, 0xf0, 0x79, 0xc1, 0xb2, 0xb4, 0x9b, 0xca, 0x30, 0x6f, 0x90, 0x7a, 0x34, 0x7f,
+  0xd4, 0x20, 0xc6, 0x11, 0x47, 0x51, 0x57, 0x03, 0x69, 0xdb, 0x5e, 0x79, 0xd9, 0x81, 0xf5, 0x91,
+  0x8d, 0x89, 0x00, 0x0f, 0xfc, 0x1f, 0xfc, 0x97, 0x9a, 0x9a, 0x6c, 0xe4, 0x7c, 0x4d, 0x81, 0xf3,
+  0x99, 0x56, 0x18, 0x69, 0x96, 0xca, 0x34, 0xbe, 0x5e, 0x83, 0x42, 0x3a, 0xeb, 0x9a, 0x63, 0x80,
+  0xa9, 0x69, 0x06, 0xed, 0x13, 0x2d, 0x24, 0xe8, 0xd1, 0x0c, 0x53, 0x35, 0x3d, 0x77, 0x6a, 0x9c,
+  0xe6, 0x47, 0x24, 0x1e, 0xbb, 0x8f, 0xf9, 0x9a, 0x9a, 0x7f, 0x96, 0x41, 0x2a, 0x58, 0x4b, 0x4f,
+  0x8c, 0x7b, 0x99, 0xc1, 0x83, 0xc5, 0x28, 0x9e, 0xc6, 0xcc, 0x71, 0x68, 0xe3, 0xd8, 0x1f, 0x43,
+  0x1b, 0x15, 0x39, 0xdb, 0x82, 0xea, 0x69, 0x6f, 0x31, 0x14, 0x3a, 0xc6, 0x74, 0x76, 0x3e, 0x46,
+  0xa8, 0x9f, 0xcf, 0x50, 0xaf, 0x98, 0x29, 0xe3, 0x7e, 0x78, 0x82, 0xd3, 0xf8, 0xd3, 0xe4, 0x0f,
+  0x3b, 0x82, 0x1a, 0x52, 0xaa, 0x08, 0x00, 0x00,
+};
+const WebAsset INDEX_PAGE = { INDEX_PAGE_GZ, sizeof(INDEX_PAGE_GZ), "text/html", "\"eecf60f80b8306e0\"", "no-cache" };
+
+// script.js: 7795 bytes, 2329 gzipped
+const uint8_t JAVASCRIPT_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xad, 0x58, 0x5f, 0x6f, 0xdb, 0x38,
+  0x12, 0x7f, 0xf7, 0xa7, 0x60, 0x7d, 0xc0, 0x4a, 0xde, 0x2a, 0x4a, 0x72, 0xb7, 0x4f, 0x0e, 0x82,
+  0x43, 0xda, 0xa4, 0x8b, 0xde, 0x75, 0x93, 0xa2, 0xce, 0xe2, 0x70, 0xd0, 0xfa, 0x0c, 0x5a, 0xa2,
+  0x6d, 0xb5, 0xb2, 0xa8, 0xa5, 0xa8, 0xa4, 0xbe, 0x6c, 0xbe, 0xfb, 0xcd, 0x0c, 0x49, 0x89, 0x92,
+  0x9c, 0xe0, 0x1e, 0xf6, 0xa5, 0xb5, 0x86, 0xc3, 0xf9, 0x3f, 0xbf, 0x19, 0x26, 0xdc, 0x34, 0x65,
+  0xaa, 0x73, 0x59, 0x86, 0x33, 0xf6, 0x34, 0x79, 0xe0, 0x8a, 0x2d, 0x6e, 0xee, 0xef, 0x3f, 0xde,
+  0xfe, 0xbc, 0xfa, 0xe7, 0xcd, 0xbf, 0x17, 0xec, 0x92, 0x25, 0x93, 0xe9, 0xfe, 0x77, 0xad, 0xe3,
+  0x5a, 0xa8, 0x07, 0xa1, 0xa6, 0x91, 0xfd, 0xd4, 0xb2, 0xca, 0xd3, 0x55, 0xa5, 0xc4, 0x26, 0xff,
+  0xde, 0x12, 0x1b, 0x60, 0x2a, 0xf9, 0x5e, 0xb4, 0x84, 0x8a, 0xd7, 0xf5, 0xa3, 0x54, 0x59, 0x4b,
+  0xe0, 0xdb, 0xad, 0x12, 0x5b, 0xae, 0xc5, 0xaa, 0xd6, 0xf0, 0x6f, 0xc7, 0x28, 0xd4, 0xaa, 0x16,
+  0x65, 0x2d, 0xd5, 0x8a, 0x24, 0xd7, 0x78, 0xb2, 0xd3, 0xba, 0x8a, 0x91, 0xf9, 0x91, 0x1f, 0x56,
+  0x9d, 0x7e, 0x22, 0xef, 0xf6, 0x3c, 0x05, 0x5a, 0xaa, 0x84, 0x6e, 0x69, 0x6b, 0xae, 0xd3, 0xdd,
+  0xaa, 0xe2, 0x7a, 0x87, 0x24, 0x9e, 0xed, 0xf3, 0x32, 0xde, 0x14, 0x7c, 0xeb, 0xdd, 0x1d, 0x11,
+  0x57, 0x95, 0x54, 0xfa, 0xf8, 0x89, 0xce, 0xf7, 0x42, 0x36, 0xde, 0xa1, 0xef, 0x9e, 0xa1, 0xf8,
+  0xfe, 0x19, 0x8a, 0x04, 0x4f, 0xb8, 0xce, 0xcb, 0xed, 0x6a, 0x2f, 0x33, 0x8f, 0xf3, 0x51, 0xac,
+  0x57, 0x4d, 0x3e, 0xd0, 0x56, 0xea, 0x6a, 0x55, 0x1f, 0xca, 0x74, 0x25, 0x40, 0xdf, 0xa1, 0xa3,
+  0xef, 0xf9, 0xf7, 0x55, 0x5a, 0xc8, 0xf4, 0xdb, 0x2a, 0x53, 0xf9, 0x86, 0x2e, 0xe8, 0x9d, 0x50,
+  0x7b, 0xb9, 0x17, 0x5a, 0xa8, 0x3a, 0x6e, 0xaa, 0x0c, 0x43, 0x98, 0x97, 0xf0, 0xf5, 0xc0, 0x8b,
+  0xd1, 0x79, 0x25, 0x8b, 0xe2, 0xe5, 0x53, 0x94, 0xae, 0x04, 0xcf, 0xd0, 0x48, 0xbe, 0x15, 0xa3,
+  0x73, 0x25, 0x6a, 0x59, 0x34, 0x58, 0x13, 0xa3, 0x23, 0x9e, 0xf1, 0x4a, 0xe7, 0x0f, 0x62, 0xf5,
+  0x0a, 0x4f, 0x53, 0x15, 0x92, 0x67, 0x9d, 0x4b, 0xbd, 0x43, 0x93, 0xa2, 0x3a, 0xff, 0xef, 0x58,
+  0xad, 0x4d, 0xff, 0xba, 0xa9, 0x57, 0x55, 0x5e, 0x4e, 0x27, 0xcb, 0x0b, 0x2a, 0xc7, 0x2f, 0x57,
+  0xd7, 0x1f, 0xef, 0x56, 0x1f, 0x3e, 0xde, 0x7c, 0xba, 0xc6, 0x72, 0x7c, 0x7a, 0x21, 0xd0, 0x73,
+  0x96, 0x4c, 0x79, 0x01, 0x85, 0x52, 0xaf, 0xd0, 0x26, 0x36, 0xcd, 0x84, 0x80, 0xe0, 0x16, 0xf0,
+  0xef, 0x74, 0xf9, 0xff, 0xb8, 0x81, 0x02, 0xb4, 0x6a, 0x04, 0xde, 0xdd, 0xf0, 0xa2, 0x16, 0x74,
+  0xed, 0x68, 0xd1, 0xbe, 0xc2, 0x3a, 0xae, 0xe3, 0x23, 0xcc, 0x93, 0x67, 0xe3, 0xda, 0xe7, 0xab,
+  0xc5, 0xe2, 0x5f, 0x77, 0x5f, 0xae, 0x8f, 0x78, 0xd7, 0x16, 0xd6, 0x9c, 0x9d, 0x8f, 0x9a, 0xc9,
+  0xd0, 0x46, 0x6d, 0x00, 0x64, 0x27, 0x39, 0x6d, 0x94, 0x12, 0xa5, 0x5e, 0x08, 0x8d, 0x11, 0xaa,
+  0x51, 0xb2, 0x3d, 0xd9, 0xe4, 0x65, 0x06, 0x9f, 0x6d, 0xd7, 0xd7, 0xa2, 0x10, 0xa9, 0x96, 0x2a,
+  0x62, 0x4a, 0x4a, 0x8d, 0x18, 0x00, 0xa2, 0x1a, 0x55, 0xb2, 0x10, 0xbf, 0xd9, 0x1f, 0x7f, 0xb0,
+  0x4c, 0xa6, 0xcd, 0x1e, 0x84, 0xcd, 0xe2, 0xdf, 0x1b, 0x48, 0xe9, 0xc2, 0x5e, 0x68, 0x6f, 0xce,
+  0x2e, 0x9c, 0x56, 0x20, 0x20, 0xa3, 0x2f, 0x5e, 0xf3, 0x6d, 0xc4, 0xb8, 0xd6, 0x2a, 0x5f, 0x37,
+  0x5a, 0xd4, 0x11, 0x4b, 0x77, 0x79, 0x91, 0x81, 0x6d, 0x0e, 0x6d, 0x44, 0xb1, 0xc7, 0x0b, 0x4e,
+  0x49, 0x0c, 0x9e, 0x40, 0x88, 0x6f, 0x8c, 0x24, 0xbc, 0x0e, 0xe2, 0xef, 0xd6, 0x5f, 0x41, 0x53,
+  0xfc, 0x4d, 0x1c, 0xea, 0xb0, 0x93, 0x85, 0xb6, 0x3d, 0x3d, 0xcf, 0xe2, 0x8d, 0x54, 0x37, 0x3c,
+  0xdd, 0x85, 0xad, 0x4e, 0xe0, 0x43, 0xe9, 0x28, 0x39, 0x81, 0xdf, 0x4b, 0x10, 0xdf, 0xdd, 0x22,
+  0x0a, 0x58, 0x0c, 0x62, 0x43, 0x67, 0x0b, 0x4a, 0x4a, 0x96, 0x47, 0x24, 0x11, 0x83, 0x93, 0x15,
+  0xf3, 0xaa, 0x12, 0x65, 0xf6, 0x1e, 0x69, 0xa1, 0x3e, 0x54, 0x42, 0x6e, 0x8c, 0x37, 0xec, 0xf2,
+  0xf2, 0x92, 0x05, 0x35, 0x68, 0x28, 0xb7, 0x01, 0xfb, 0xfb, 0xd0, 0x97, 0x7b, 0xf1, 0x5d, 0xdf,
+  0x42, 0x89, 0x3a, 0x69, 0x73, 0x73, 0x6b, 0x66, 0x8c, 0xb0, 0xd1, 0x46, 0x05, 0x6d, 0x1c, 0x75,
+  0xae, 0x0b, 0x01, 0x2d, 0xd2, 0xcb, 0x93, 0x97, 0x1a, 0xe8, 0x95, 0xaa, 0xc8, 0x75, 0x78, 0x9a,
+  0xb0, 0xd5, 0xf2, 0xed, 0xe9, 0x0c, 0x3a, 0xba, 0xea, 0x8c, 0xc6, 0x12, 0xf1, 0x98, 0xf1, 0x33,
+  0xae, 0x9b, 0x35, 0xd8, 0x17, 0x9e, 0x45, 0xec, 0x7c, 0x06, 0xd0, 0xfd, 0x2b, 0x78, 0xa2, 0xde,
+  0xf3, 0x5a, 0x00, 0xe8, 0xbf, 0xed, 0x71, 0x9c, 0x93, 0x59, 0xf1, 0x57, 0x99, 0x97, 0x61, 0xc0,
+  0x82, 0x2e, 0xb7, 0xf5, 0x4e, 0x3e, 0xbe, 0xe3, 0x65, 0x29, 0x94, 0x6f, 0xd5, 0x5e, 0xd4, 0x35,
+  0x40, 0x48, 0xc4, 0x30, 0x1e, 0x2e, 0xa5, 0xeb, 0x96, 0x0d, 0x6a, 0x2d, 0x0c, 0xfe, 0x62, 0xbe,
+  0x51, 0x96, 0xf9, 0x15, 0x6b, 0x88, 0xc8, 0x7b, 0x09, 0xf0, 0x44, 0xb5, 0x62, 0x65, 0xb4, 0xa7,
+  0x69, 0x01, 0x75, 0x7e, 0x0b, 0x30, 0x0b, 0x67, 0x01, 0x2f, 0x84, 0xd2, 0x2c, 0x00, 0x2b, 0x51,
+  0xc3, 0xc5, 0x24, 0x2d, 0x04, 0x57, 0xf7, 0x06, 0x98, 0xc3, 0xce, 0xa6, 0x18, 0xb1, 0x1a, 0x2b,
+  0x71, 0x48, 0x02, 0x19, 0xb5, 0xd0, 0xee, 0x82, 0x3f, 0xeb, 0xd8, 0xcb, 0xea, 0x76, 0x79, 0x96,
+  0x89, 0x32, 0xb8, 0x60, 0xcf, 0x11, 0xfb, 0xe9, 0xec, 0xec, 0xac, 0x1f, 0x85, 0x1b, 0xa5, 0x64,
+  0x2f, 0x08, 0xe4, 0x78, 0x2a, 0xa1, 0xe9, 0x0b, 0x11, 0x17, 0x72, 0x0b, 0x04, 0xdf, 0x90, 0x30,
+  0xb8, 0x29, 0x53, 0xd9, 0x20, 0x1a, 0x8b, 0x8c, 0x71, 0xc8, 0x35, 0x0a, 0x08, 0x22, 0xab, 0xed,
+  0x24, 0xe3, 0xe5, 0xd6, 0x84, 0xc7, 0x2a, 0x51, 0x02, 0x1a, 0xad, 0xd6, 0xfd, 0x38, 0xeb, 0x9d,
+  0xcc, 0x22, 0xd6, 0xa8, 0x22, 0x62, 0x6b, 0x99, 0x1d, 0x5c, 0xac, 0x65, 0x85, 0xe7, 0xd4, 0xe0,
+  0x86, 0x67, 0xce, 0x1c, 0x2f, 0x54, 0x1f, 0x78, 0xa1, 0x73, 0xc0, 0x9c, 0x39, 0x94, 0x27, 0x78,
+  0x78, 0x22, 0x55, 0xbe, 0xcd, 0xcb, 0x00, 0xf4, 0xe4, 0x1b, 0x16, 0x3a, 0x39, 0x56, 0x46, 0xbc,
+  0x83, 0x99, 0x00, 0xe8, 0x88, 0xb2, 0x02, 0x9b, 0x9e, 0x93, 0x7b, 0x88, 0x7a, 0x00, 0xd7, 0xa1,
+  0xf6, 0x8b, 0x3c, 0xe5, 0xc8, 0x78, 0xfa, 0xb5, 0x96, 0x24, 0xc3, 0xdd, 0x43, 0x39, 0x70, 0xe9,
+  0x1f, 0x8b, 0xbb, 0xdb, 0xd8, 0x74, 0x41, 0xbe, 0x39, 0x18, 0xe9, 0xe0, 0x93, 0xab, 0xc3, 0x8d,
+  0x00, 0xe4, 0x0f, 0xc9, 0x01, 0x7b, 0x11, 0x2a, 0x71, 0x27, 0xca, 0x2e, 0x29, 0x00, 0xc6, 0x15,
+  0x90, 0x29, 0x9c, 0x68, 0xdf, 0x1b, 0xe6, 0x28, 0xb1, 0xfc, 0x86, 0x44, 0xbd, 0x53, 0xf2, 0x91,
+  0x95, 0xe2, 0x91, 0x51, 0x0e, 0x6c, 0x54, 0xa0, 0x36, 0x02, 0xaa, 0x10, 0x90, 0x4d, 0xbf, 0x37,
+  0x3c, 0x2f, 0x20, 0xd2, 0x8f, 0xb9, 0xde, 0x11, 0xbd, 0x95, 0x82, 0xe8, 0xdd, 0xd4, 0xbe, 0x51,
+  0xed, 0x11, 0xfa, 0x14, 0xda, 0x96, 0x74, 0xb9, 0x16, 0x0a, 0x62, 0x07, 0x6d, 0xf8, 0x41, 0xaa,
+  0xbd, 0x9f, 0x0c, 0x80, 0x89, 0xbd, 0x8b, 0x3f, 0xcc, 0x61, 0x6e, 0xd1, 0xf5, 0x4a, 0x29, 0x7e,
+  0x88, 0x2b, 0x25, 0xb5, 0xc4, 0x5a, 0x75, 0x68, 0x12, 0xa7, 0xbc, 0x28, 0xe8, 0x4e, 0x6c, 0xf1,
+  0x11, 0x50, 0xb0, 0x93, 0x95, 0x0b, 0x83, 0x30, 0xc6, 0x61, 0xfa, 0x8c, 0x71, 0xc7, 0x40, 0x4c,
+  0x32, 0x5f, 0x59, 0x5e, 0xf3, 0x35, 0x3a, 0xd4, 0x52, 0x50, 0xbc, 0x05, 0x9d, 0x66, 0xbd, 0xcf,
+  0x75, 0x80, 0x47, 0xe1, 0xf0, 0x4c, 0xc1, 0x84, 0x97, 0x01, 0xfb, 0xe1, 0x07, 0xe6, 0xe4, 0xa6,
+  0x3b, 0x91, 0x7e, 0x13, 0xd9, 0xac, 0x43, 0x07, 0x0c, 0x05, 0xba, 0xb1, 0xe3, 0xf5, 0xee, 0x17,
+  0x1c, 0xcd, 0xd4, 0xb5, 0xce, 0x06, 0xc0, 0x15, 0xcc, 0xd9, 0x69, 0x98, 0xfc, 0xe7, 0xb7, 0x64,
+  0xf9, 0x76, 0xf6, 0x5b, 0x82, 0xbf, 0x96, 0xf8, 0x6b, 0x79, 0x3a, 0x33, 0x45, 0xd4, 0xde, 0x44,
+  0xa1, 0x18, 0x8d, 0xa4, 0xa5, 0x24, 0xe7, 0x4b, 0xc4, 0xde, 0x23, 0x44, 0x42, 0xee, 0x8b, 0x23,
+  0xec, 0xde, 0xd7, 0x5f, 0xe9, 0xb2, 0x31, 0x06, 0xb6, 0x98, 0x06, 0x9a, 0xff, 0x19, 0x60, 0xb2,
+  0x16, 0x4e, 0x4f, 0x67, 0xe7, 0x98, 0xd1, 0x87, 0x56, 0x64, 0xf6, 0x7a, 0xab, 0x84, 0x1a, 0x47,
+  0x48, 0xfe, 0x80, 0x17, 0xfa, 0x93, 0x90, 0x86, 0xa5, 0x07, 0x9d, 0xc9, 0xc4, 0x66, 0x2c, 0x0c,
+  0x0a, 0xbe, 0x16, 0x05, 0xf4, 0xec, 0x53, 0x0b, 0x17, 0xd0, 0x14, 0xd0, 0xf3, 0x5a, 0xc9, 0xe2,
+  0xc4, 0x1d, 0x7a, 0xb8, 0x36, 0x67, 0x56, 0x5c, 0x4c, 0x60, 0xfe, 0x3c, 0x8b, 0x3a, 0x59, 0x79,
+  0x59, 0x35, 0x1a, 0x65, 0x4d, 0x7c, 0x61, 0x58, 0x21, 0x27, 0x56, 0x62, 0x10, 0x4d, 0x4a, 0xa2,
+  0x3a, 0x21, 0x30, 0xb4, 0xa2, 0x09, 0xa6, 0x76, 0x3e, 0x5c, 0x1a, 0x12, 0x8f, 0x65, 0x09, 0xc3,
+  0x27, 0x70, 0x5b, 0x42, 0x00, 0x83, 0x26, 0x40, 0x8b, 0x40, 0x18, 0x85, 0xa5, 0x93, 0x46, 0x9f,
+  0x54, 0x24, 0x0d, 0x44, 0x03, 0x50, 0x1a, 0x8a, 0x0b, 0x6e, 0xe2, 0x8d, 0x1e, 0x4b, 0x34, 0x71,
+  0xb5, 0x37, 0x67, 0x6f, 0xde, 0xb8, 0x23, 0x47, 0x83, 0x18, 0xe3, 0x8e, 0xd6, 0x0b, 0xec, 0x17,
+  0xac, 0xb9, 0xd7, 0x22, 0x8b, 0xac, 0x5b, 0x25, 0x9b, 0x0a, 0xce, 0xdb, 0x80, 0x64, 0xf9, 0xc3,
+  0x30, 0xb4, 0x6b, 0x5d, 0x9e, 0x98, 0x02, 0xc6, 0x4c, 0xfa, 0x3b, 0x60, 0xcf, 0xe1, 0xf1, 0xc8,
+  0x36, 0xd8, 0x82, 0xaa, 0x48, 0x4d, 0x6f, 0x68, 0xbf, 0x9e, 0x4d, 0x50, 0x19, 0x00, 0xe0, 0x27,
+  0x47, 0x12, 0x65, 0x22, 0x6f, 0x3b, 0x2a, 0x62, 0xe3, 0xdc, 0x30, 0x1b, 0x61, 0xa3, 0x1d, 0xb3,
+  0xed, 0x66, 0xb8, 0x33, 0x68, 0xb2, 0x9c, 0xf5, 0x27, 0x7e, 0xf2, 0x27, 0xd6, 0x96, 0x09, 0x69,
+  0x97, 0x0c, 0xe3, 0xf4, 0x55, 0x51, 0xf8, 0x59, 0xa8, 0x38, 0xae, 0x84, 0xfd, 0x0d, 0xcc, 0xfd,
+  0x7e, 0x79, 0xf5, 0x61, 0xe6, 0x5a, 0x2f, 0x8e, 0x76, 0x7f, 0x61, 0x1e, 0x58, 0xe2, 0x7c, 0x38,
+  0xdc, 0x7b, 0x3b, 0xb6, 0xaf, 0x19, 0x3b, 0xd0, 0x25, 0x1f, 0x10, 0x15, 0xf6, 0x8e, 0xba, 0xdb,
+  0x0e, 0x2c, 0xe1, 0x04, 0xeb, 0xdf, 0x74, 0x31, 0x78, 0x17, 0x58, 0x74, 0xc1, 0x9b, 0x71, 0x21,
+  0xca, 0x2d, 0x40, 0x39, 0x94, 0xeb, 0x19, 0x4a, 0xb1, 0x17, 0x8e, 0x67, 0x36, 0xa7, 0x74, 0xf9,
+  0xb1, 0x0a, 0x6e, 0x25, 0xf3, 0x97, 0x7f, 0x96, 0xc1, 0x7f, 0xa9, 0x16, 0x59, 0xcc, 0xd8, 0xbd,
+  0x3a, 0x30, 0x02, 0x45, 0x08, 0x26, 0x83, 0x88, 0x97, 0x22, 0x35, 0xe3, 0x94, 0xc3, 0x92, 0x0c,
+  0xb3, 0x41, 0x73, 0x85, 0x71, 0x86, 0x1a, 0x6c, 0xf3, 0xe6, 0x10, 0x13, 0x5f, 0x99, 0x9d, 0x17,
+  0xce, 0xee, 0x04, 0x0d, 0x3e, 0x81, 0x39, 0x29, 0xb6, 0x52, 0x1d, 0x2e, 0x69, 0x47, 0x9f, 0x2e,
+  0xd1, 0x1b, 0xda, 0xeb, 0xc4, 0x9e, 0x1e, 0x2d, 0x8d, 0xf2, 0x03, 0x60, 0x77, 0xf5, 0x13, 0xff,
+  0xd4, 0xdd, 0x30, 0x4f, 0x89, 0xcf, 0x56, 0xd7, 0x60, 0xab, 0x4f, 0x02, 0x7a, 0x02, 0xd8, 0xe7,
+  0x06, 0x19, 0x14, 0xb4, 0xd8, 0x4a, 0x9f, 0xc7, 0x63, 0xb4, 0xfb, 0x69, 0x1c, 0x24, 0x52, 0x61,
+  0xfc, 0xa4, 0x98, 0x8f, 0xea, 0xc1, 0x0b, 0xa1, 0x4b, 0x25, 0x55, 0x1f, 0x98, 0xe5, 0x1d, 0xc5,
+  0x79, 0x66, 0x12, 0xe7, 0xd3, 0xb0, 0x5d, 0x68, 0x7c, 0x13, 0xff, 0x5b, 0x18, 0x4d, 0x2c, 0xa4,
+  0x8d, 0x6e, 0xc0, 0x83, 0xc3, 0x7b, 0x16, 0x60, 0x80, 0xdb, 0xfa, 0x0d, 0x6d, 0xb2, 0xa3, 0x21,
+  0x70, 0x87, 0x4f, 0xd0, 0x76, 0xf3, 0x81, 0xea, 0xc8, 0x98, 0x34, 0x26, 0xdb, 0xee, 0x1c, 0x2a,
+  0x24, 0x77, 0x3b, 0x5d, 0x14, 0xb2, 0x23, 0x9a, 0x26, 0xa4, 0x6a, 0x1c, 0xec, 0x64, 0xe8, 0x44,
+  0x4e, 0xbb, 0xc8, 0x32, 0xb0, 0xdd, 0x3f, 0x37, 0xe6, 0x78, 0xf0, 0xdb, 0x26, 0x33, 0xe9, 0x5f,
+  0x83, 0x17, 0x61, 0xdf, 0x14, 0xbf, 0x16, 0x5e, 0xf2, 0x3d, 0x08, 0x3a, 0x7f, 0x49, 0xcf, 0x31,
+  0x37, 0x3d, 0x41, 0x11, 0xeb, 0xd0, 0x1c, 0x1f, 0xa4, 0xcf, 0xb3, 0xfe, 0xbe, 0x43, 0x2d, 0xec,
+  0xbd, 0x18, 0x47, 0xed, 0x3b, 0x7e, 0x54, 0x9a, 0xd1, 0xea, 0x3f, 0xcf, 0x88, 0xf7, 0xc5, 0x27,
+  0x19, 0xaa, 0xb1, 0xc3, 0x87, 0x2d, 0x68, 0x53, 0xa4, 0x0b, 0xf4, 0x26, 0xb3, 0x1d, 0xdf, 0x83,
+  0x7a, 0xa2, 0xdb, 0x7b, 0x04, 0xbe, 0x6d, 0xd7, 0x10, 0x34, 0x27, 0x98, 0xc4, 0xcb, 0x29, 0xa6,
+  0x01, 0x38, 0x31, 0xf6, 0xd3, 0x65, 0x42, 0xf2, 0x0d, 0xd1, 0xa8, 0x22, 0xb2, 0x03, 0x14, 0x92,
+  0x42, 0x23, 0x1e, 0x7f, 0xb8, 0x8d, 0x08, 0x8b, 0x58, 0xd9, 0xc5, 0xc1, 0xed, 0x18, 0xa8, 0x93,
+  0xb4, 0x74, 0x9d, 0x6a, 0x61, 0xd7, 0x62, 0xd5, 0x8b, 0x26, 0x38, 0x5d, 0xc4, 0x40, 0xbb, 0x1d,
+  0xfe, 0x70, 0x53, 0x97, 0x75, 0x3b, 0x4a, 0x6f, 0xdb, 0xe4, 0x0f, 0x47, 0x17, 0x4d, 0xc8, 0xb1,
+  0xe2, 0x65, 0xed, 0x76, 0x4e, 0xda, 0x23, 0x79, 0x96, 0xdd, 0x3c, 0x40, 0x26, 0x3e, 0xe5, 0x35,
+  0xb4, 0x2f, 0xbe, 0x30, 0xec, 0x1e, 0x18, 0x0d, 0x1e, 0x25, 0x02, 0xd6, 0x51, 0x81, 0x9c, 0xd7,
+  0x62, 0xc3, 0x9b, 0x42, 0x87, 0x04, 0x63, 0xf4, 0xba, 0x08, 0x83, 0xcf, 0xbf, 0xde, 0xe3, 0x23,
+  0xe4, 0xd4, 0x79, 0x15, 0x78, 0xaa, 0xc2, 0xde, 0xf2, 0x6b, 0x36, 0xde, 0xd9, 0x6c, 0x32, 0x58,
+  0xd8, 0x71, 0x3c, 0xf8, 0xef, 0x9c, 0x05, 0xf8, 0x90, 0x75, 0x0f, 0x9b, 0xba, 0x49, 0x53, 0x78,
+  0xdb, 0x05, 0x34, 0x29, 0x26, 0xb0, 0x07, 0xe3, 0x32, 0xd9, 0xbe, 0xa0, 0xfa, 0xc5, 0xb7, 0x6e,
+  0x00, 0xa2, 0x5c, 0x65, 0x0d, 0xe3, 0xe0, 0x4a, 0x60, 0x63, 0xe9, 0x47, 0xb2, 0xd1, 0x02, 0x26,
+  0x05, 0xa2, 0x65, 0x82, 0x27, 0xbf, 0x86, 0xc7, 0x4a, 0x44, 0x57, 0x2d, 0x0b, 0xd6, 0xe9, 0xbb,
+  0xc3, 0x7b, 0x8b, 0xd1, 0x76, 0x79, 0xf7, 0xff, 0xe8, 0xf9, 0x6a, 0xf9, 0xa6, 0xdd, 0x3d, 0xa0,
+  0xda, 0x87, 0x78, 0x10, 0x07, 0xb3, 0xe4, 0x0c, 0xe6, 0x6f, 0xd8, 0x17, 0x9e, 0x38, 0xee, 0xa5,
+  0x61, 0x3f, 0x7e, 0x64, 0xff, 0xfa, 0x50, 0x35, 0xf5, 0x8e, 0x34, 0x99, 0xc0, 0xf8, 0x5d, 0xd5,
+  0xbf, 0x7a, 0xec, 0x0f, 0x15, 0xee, 0xc8, 0x45, 0xca, 0xce, 0x23, 0x7f, 0xcb, 0x6a, 0x67, 0xeb,
+  0x60, 0xd3, 0xa0, 0xc5, 0x93, 0x16, 0x08, 0xda, 0xb5, 0x1c, 0x1b, 0x40, 0x9d, 0xbe, 0x72, 0x7f,
+  0x36, 0x81, 0x1d, 0xcd, 0x1f, 0x6c, 0x20, 0xa2, 0xd5, 0x78, 0x31, 0x79, 0xc9, 0xb1, 0x57, 0xe3,
+  0x68, 0xb3, 0x87, 0xe1, 0x27, 0x34, 0xa3, 0x2d, 0xca, 0x87, 0x33, 0xdc, 0x9d, 0x06, 0x11, 0x3e,
+  0x5f, 0xce, 0x9e, 0x7d, 0x94, 0x74, 0xa6, 0x46, 0x6c, 0x84, 0x1a, 0xb0, 0xcf, 0x0e, 0x37, 0xd2,
+  0x6e, 0x0d, 0x9d, 0x8f, 0x10, 0xd5, 0x1d, 0xd9, 0xd8, 0x53, 0x97, 0xe5, 0xf0, 0x2e, 0x54, 0xfa,
+  0x9d, 0x80, 0x0f, 0xe1, 0x0d, 0xcf, 0xbf, 0x8d, 0x36, 0x35, 0xeb, 0xef, 0x09, 0x99, 0x3d, 0x5c,
+  0xd5, 0x5a, 0x5f, 0xda, 0x80, 0xe1, 0xbe, 0x66, 0xca, 0xf4, 0xa8, 0xa6, 0xce, 0xa9, 0x96, 0xc9,
+  0xf6, 0x49, 0xfb, 0x77, 0xa5, 0x71, 0xff, 0x5f, 0xdf, 0xfd, 0x62, 0x35, 0x7e, 0x92, 0xf0, 0x88,
+  0xcf, 0x7c, 0x24, 0xc0, 0x88, 0x8f, 0xda, 0x0b, 0x91, 0xc0, 0x41, 0x4e, 0x78, 0xbc, 0xa1, 0xa2,
+  0xd1, 0x04, 0x60, 0xfe, 0x8b, 0x8a, 0xb6, 0xbf, 0xa1, 0x08, 0x7f, 0x99, 0x7b, 0x4d, 0xc2, 0xd3,
+  0xe0, 0xef, 0xb1, 0xe6, 0xda, 0x74, 0x4e, 0xa2, 0x9f, 0x8d, 0x6c, 0x23, 0x32, 0x4e, 0xe5, 0x7e,
+  0x0f, 0xeb, 0x98, 0x15, 0xf9, 0x67, 0x61, 0xdf, 0xdd, 0xc2, 0x80, 0x9f, 0x95, 0x8e, 0xe0, 0xd7,
+  0x87, 0x3c, 0xbd, 0xcb, 0xeb, 0x59, 0x8b, 0x5a, 0x3d, 0xc8, 0x3b, 0xfd, 0x91, 0xc1, 0xa6, 0x0b,
+  0x7b, 0xe4, 0x43, 0x9e, 0x0a, 0xb7, 0x26, 0xd6, 0x6c, 0x4d, 0xf9, 0x83, 0x6f, 0x18, 0xa3, 0x58,
+  0xd9, 0x3f, 0x9e, 0x9a, 0x10, 0xf9, 0x00, 0x09, 0xe6, 0x1c, 0xc3, 0x47, 0xfb, 0x2e, 0xb0, 0xc6,
+  0xfd, 0x7c, 0x33, 0x00, 0x66, 0x07, 0xbc, 0xbd, 0x09, 0x7d, 0x14, 0x8d, 0xdb, 0x3f, 0x6b, 0x0c,
+  0x44, 0xf9, 0xd1, 0x76, 0x78, 0xdc, 0x89, 0xf4, 0xf7, 0xf6, 0x97, 0x81, 0x7a, 0x06, 0x11, 0xfc,
+  0x1f, 0xa2, 0xf3, 0xf1, 0x48, 0x2e, 0x1a, 0x00, 0x00,
+};
+const WebAsset JAVASCRIPT = { JAVASCRIPT_GZ, sizeof(JAVASCRIPT_GZ), "application/javascript", "\"ffe4009181e738da\"", "public, max-age=31536000, immutable" };
+
+// style.css: 1878 bytes, 678 gzipped
+const uint8_t STYLESHEET_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x7d, 0x54, 0x5d, 0x8f, 0x9b, 0x30,
+  0x10, 0xfc, 0x2b, 0xe8, 0x4e, 0x7d, 0xa9, 0x62, 0x64, 0x20, 0xe9, 0x5d, 0xcc, 0x53, 0xdf, 0xda,
+  0xd7, 0x56, 0xfd, 0x01, 0xfe, 0x58, 0x27, 0xd6, 0x19, 0x1b, 0xd9, 0xce, 0x25, 0x39, 0xc4, 0x7f,
+  0xaf, 0x4d, 0x20, 0xc0, 0xf5, 0xae, 0x8a, 0x84, 0xe4, 0xb0, 0xcc, 0xce, 0xcc, 0xce, 0xfa, 0x6b,
+  0xc7, 0xec, 0x05, 0x79, 0xf5, 0xa6, 0xcc, 0x81, 0x30, 0xeb, 0x04, 0x38, 0x14, 0xff, 0xe9, 0x99,
+  0x15, 0xd7, 0xae, 0xa1, 0xee, 0xa0, 0x0c, 0xc1, 0xb5, 0xb4, 0x26, 0x20, 0x49, 0x1b, 0xa5, 0xaf,
+  0x04, 0xd1, 0xb6, 0xd5, 0x80, 0xfc, 0xd5, 0x07, 0x68, 0x36, 0x0f, 0xbf, 0xe1, 0x60, 0x21, 0xfb,
+  0xf3, 0xf3, 0x61, 0xf3, 0xcb, 0x32, 0x1b, 0xec, 0xe6, 0x07, 0xe8, 0x57, 0x08, 0x8a, 0xd3, 0xcd,
+  0x77, 0xa7, 0xa8, 0xde, 0x78, 0x6a, 0x3c, 0xf2, 0xe0, 0x94, 0xbc, 0xc1, 0xc4, 0x5e, 0x40, 0x8a,
+  0x5d, 0x7b, 0xa9, 0xb5, 0x32, 0x80, 0x8e, 0xa0, 0x0e, 0xc7, 0x40, 0x8a, 0x7c, 0x5b, 0x73, 0xab,
+  0xad, 0x23, 0x8f, 0x55, 0x55, 0xf5, 0xb4, 0x1b, 0x0f, 0xe5, 0xd3, 0x33, 0x86, 0xaa, 0x0e, 0x70,
+  0x09, 0x48, 0x00, 0xb7, 0x8e, 0x06, 0x65, 0x0d, 0x31, 0xd6, 0x40, 0x9f, 0xf3, 0x88, 0x47, 0x23,
+  0x88, 0x8b, 0x4c, 0x2f, 0xe8, 0xac, 0x44, 0x38, 0x92, 0xa2, 0x78, 0xc2, 0x11, 0x7b, 0xa2, 0x9e,
+  0xd1, 0x53, 0xb0, 0x75, 0x4b, 0x85, 0x48, 0x02, 0x71, 0x96, 0x1a, 0xf7, 0xb9, 0xa1, 0xaf, 0x8c,
+  0xba, 0xae, 0xb5, 0x5e, 0x0d, 0x70, 0x52, 0x5d, 0x40, 0xd4, 0xc1, 0xb6, 0x51, 0xeb, 0x08, 0x83,
+  0xf1, 0x97, 0xfa, 0x0d, 0x29, 0x23, 0xe0, 0x12, 0x0f, 0x35, 0xa3, 0xfc, 0xe5, 0xe0, 0xec, 0xc9,
+  0x88, 0xc8, 0xa9, 0x2c, 0x27, 0x88, 0x8c, 0x76, 0x42, 0xf9, 0x56, 0xd3, 0x2b, 0x51, 0x66, 0xd0,
+  0xc3, 0xb4, 0xe5, 0x2f, 0xf7, 0x86, 0xa9, 0x5d, 0x56, 0x24, 0x42, 0xa3, 0x1e, 0x29, 0xe5, 0xf4,
+  0x2d, 0x62, 0x8e, 0x1a, 0xd1, 0x2d, 0x4c, 0xc9, 0x4b, 0x68, 0x46, 0xe6, 0xc8, 0xdd, 0x6c, 0x81,
+  0xa6, 0xcf, 0xc3, 0x11, 0x5c, 0x63, 0x1b, 0x08, 0x71, 0x36, 0x1e, 0x78, 0x62, 0xdc, 0x8d, 0x0d,
+  0x50, 0xe2, 0xbc, 0xfd, 0xa4, 0x28, 0x3b, 0x16, 0x0b, 0xf4, 0x32, 0xdf, 0x45, 0xf4, 0xe1, 0x7c,
+  0xbe, 0x79, 0x5e, 0xe1, 0xa8, 0x6b, 0x1a, 0x79, 0x08, 0xb6, 0x21, 0x45, 0x64, 0xeb, 0xad, 0x56,
+  0x22, 0x7b, 0x14, 0x42, 0xf4, 0xb9, 0xb3, 0xe7, 0xbb, 0x3e, 0xa9, 0xe1, 0x52, 0xa7, 0x07, 0x3a,
+  0x3b, 0xda, 0x92, 0xf4, 0x98, 0x5d, 0x46, 0x37, 0x5f, 0xa3, 0xc8, 0x2e, 0x95, 0x90, 0x22, 0x2b,
+  0xb2, 0x2d, 0x4e, 0xba, 0xdf, 0x5b, 0x7f, 0x06, 0xad, 0xbb, 0xa5, 0x9b, 0x72, 0x97, 0x7e, 0x23,
+  0x91, 0x25, 0x03, 0xa8, 0xd2, 0x6f, 0xb6, 0x72, 0x7f, 0x1f, 0xeb, 0x44, 0xb7, 0xc4, 0x43, 0x53,
+  0x1a, 0x62, 0x06, 0xdd, 0x15, 0x05, 0x15, 0x34, 0x74, 0x43, 0x54, 0x42, 0xb4, 0xd6, 0x4b, 0xeb,
+  0x1a, 0x72, 0x6a, 0x5b, 0x70, 0x9c, 0x7a, 0xf8, 0x5c, 0x2a, 0xe7, 0x7c, 0x19, 0xcd, 0xfc, 0x29,
+  0xfa, 0x29, 0x15, 0x68, 0xe1, 0x21, 0x74, 0x23, 0x2f, 0x3c, 0x0b, 0x99, 0x55, 0x4f, 0x9a, 0x52,
+  0x0e, 0x9d, 0xd5, 0x48, 0x53, 0x06, 0xfa, 0x6e, 0xd8, 0x2d, 0x09, 0x63, 0x71, 0xca, 0x40, 0xac,
+  0x4f, 0xb1, 0x5f, 0x8e, 0x80, 0x59, 0x1d, 0x6d, 0x4e, 0x44, 0xd1, 0x08, 0xf2, 0xee, 0xf3, 0x45,
+  0x1a, 0x27, 0x02, 0xcf, 0x29, 0x52, 0x65, 0x04, 0xfa, 0xd7, 0xb2, 0x77, 0x4a, 0x52, 0x2e, 0x96,
+  0xd8, 0x24, 0x62, 0x53, 0xa6, 0x41, 0xac, 0x06, 0x00, 0x10, 0x57, 0x89, 0x05, 0xf3, 0xff, 0x24,
+  0x0f, 0x5d, 0xb7, 0x73, 0x57, 0xbc, 0x48, 0xf4, 0xba, 0x67, 0xcd, 0x4f, 0xce, 0xc7, 0x37, 0xad,
+  0x55, 0x26, 0xa6, 0x71, 0xc0, 0x46, 0xad, 0x53, 0xd1, 0x89, 0xeb, 0x66, 0x38, 0x38, 0x2a, 0x94,
+  0xcd, 0x86, 0x9e, 0xab, 0xbd, 0x1a, 0x76, 0xfd, 0x56, 0x2f, 0xa8, 0x39, 0xc4, 0xbd, 0x5e, 0x05,
+  0x45, 0x62, 0x5c, 0xed, 0xfb, 0x19, 0xe1, 0x43, 0xa7, 0xef, 0xf3, 0x4d, 0xe2, 0xe7, 0x66, 0xca,
+  0xb4, 0xa7, 0xd0, 0xad, 0x76, 0x6b, 0x18, 0x1d, 0xd5, 0xe0, 0x42, 0xb7, 0x5c, 0xd7, 0x0f, 0x32,
+  0xb6, 0x5a, 0xde, 0xe1, 0x8b, 0x78, 0x31, 0x48, 0xbb, 0x62, 0xb7, 0xdf, 0xef, 0xb6, 0x8c, 0x4d,
+  0xaf, 0xfd, 0x89, 0x73, 0xf0, 0x7e, 0x55, 0x51, 0x49, 0xf6, 0xad, 0x78, 0x9e, 0x2a, 0x3e, 0x17,
+  0xf8, 0xc8, 0xa8, 0x49, 0x77, 0xda, 0x07, 0xb7, 0xd3, 0x2e, 0x91, 0x19, 0x6f, 0x86, 0x44, 0x75,
+  0xba, 0xa0, 0x4a, 0xdc, 0xe7, 0x47, 0x25, 0x04, 0xcc, 0x43, 0x1c, 0x6e, 0xc8, 0xbf, 0xfa, 0x3d,
+  0x21, 0x1d, 0xde, 0x05, 0x00, 0x00,
+};
+const WebAsset STYLESHEET = { STYLESHEET_GZ, sizeof(STYLESHEET_GZ), "text/css", "\"65bb707632062590\"", "public, max-age=31536000, immutable" };
+
+#endif
@@ -1,4 +1,5 @@
 #include <inttypes.h>
+#include <vector>
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
@@ -19,110 +20,382 @@
 #include <WiFiManager.h>
 #include <ThermometerWebserver.h>
 
-#include <HmacHelpers.h>
 #include <Settings.h>
 #include <IntParsing.h>
 #include <TempIface.h>
+#include <SensorRegistry.h>
 #include <MqttClient.h>
-#include <ESP8266HTTPClient.h>
+#include <RtcState.h>
+#include <RuntimeStats.h>
+#include <FlagServerProbe.h>
+#include <GatewayClient.h>
+
+extern "C" {
+#include <user_interface.h>
+}
+
+// How long to wait on a direct connection to the cached BSSID before falling
+// back to WiFiManager
+#ifndef WIFI_FAST_CONNECT_TIMEOUT
+#define WIFI_FAST_CONNECT_TIMEOUT 3000
+#endif
+
+// Number of wakes a cached DHCP lease is reused before renewing it with a full
+// connection
+#ifndef WIFI_FAST_CONNECT_MAX_USES
+#define WIFI_FAST_CONNECT_MAX_USES 24
+#endif
+
+// Residual error assumed for the deep sleep timer after drift correction, used
+// to estimate when the restored clock needs an NTP resync
+#ifndef DEEP_SLEEP_CLOCK_UNCERTAINTY_PPM
+#define DEEP_SLEEP_CLOCK_UNCERTAINTY_PPM 5000
+#endif
+
+// Syncs shorter than this don't carry enough signal to update the drift estimate
+#define MIN_DRIFT_CALIBRATION_SECONDS 3600
+#define MAX_DRIFT_PPM 100000
+
+// Upper bound on waiting for in-flight gateway requests before deep sleep
+#ifndef GATEWAY_FLUSH_TIMEOUT
+#define GATEWAY_FLUSH_TIMEOUT 10000
+#endif
 
 MqttClient* mqttClient = NULL;
 ThermometerWebserver* server = NULL;
 OneWire* oneWire = NULL;
 DallasTemperature* sensors = NULL;
 Settings settings;
-TempIface tempIface(sensors, settings);
+SensorRegistry sensorRegistry(settings);
+TempIface tempIface(oneWire, sensors, settings, sensorRegistry);
+RtcState rtcState;
+RuntimeStats stats;
+FlagServerProbe flagServerProbe;
+GatewayClient gatewayClient(settings, stats);
 time_t lastUpdate = 0;
+bool updatePending = false;
+
+// False on deep sleep wakes that only sample into RTC memory.  The radio is
+// disabled on these wakes, so WiFi, NTP and MQTT are skipped entirely.
+bool radioEnabled = true;
+
+// Set when this boot is waiting on NTP.  If the clock was restored from RTC
+// memory, restoredEpoch/restoredAt let us measure the estimate's error.
+bool ntpSyncPending = false;
+time_t restoredEpoch = 0;
+unsigned long restoredAt = 0;
+
+// Gateway requests carrying buffered readings that haven't completed, and
+// whether any of them or an MQTT publish failed.  The RTC buffer is only
+// cleared once they've all succeeded.
+size_t uploadsPending = 0;
+bool uploadFailed = false;
+
+// Probes whose reading this wake had no room in RTC memory.  They're published
+// live with the buffered readings when the radio is up.
+std::vector<size_t> unbufferedProbes;
 
 enum class OperatingState { UNCHECKED, SETTINGS, NORMAL };
 OperatingState operatingState = OperatingState::UNCHECKED;
 
 ADC_MODE(ADC_TOUT);
 
-time_t timestamp() {
-  TimeChangeRule dstOn = {"DT", Second, dowSunday, Mar, 2, 60};
-  TimeChangeRule dstOff = {"ST", First, dowSunday, Nov, 2, 0};
-  Timezone timezone(dstOn, dstOff);
+bool isBatchMode() {
+  return settings.batchPath.length() > 0 && settings.gatewayServer.length() > 0;
+}
 
-  return timezone.toLocal(NTP.getTime());
+bool isAggregateStateMode() {
+  return mqttClient != NULL && settings.mqttAggregateState;
 }
 
-void updateTemperature(uint8_t* deviceId, float temp) {
-  String deviceName = settings.deviceName(deviceId);
-  String strDeviceId = settings.deviceName(deviceId, false);
+// Collects the readings from one update cycle for the batched HTTP request and
+// the aggregate MQTT state document.  Ids and aliases are referenced from the
+// sensor registry rather than copied, so nothing may be added to the registry
+// while a cycle is open.
+struct UpdateCycle {
+  UpdateCycle(size_t numReadings)
+    : httpBatch(isBatchMode() ? JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(numReadings) + numReadings * JSON_OBJECT_SIZE(5) : 0)
+    , mqttState(isAggregateStateMode() ? JSON_OBJECT_SIZE(numReadings) + numReadings * JSON_OBJECT_SIZE(3) : 0)
+  {
+    if (isBatchMode()) {
+      readings = httpBatch.createNestedArray("readings");
+    }
 
-  StaticJsonDocument<100> response;
-  String body;
+    if (isAggregateStateMode()) {
+      state = mqttState.to<JsonObject>();
+    }
+  }
 
-  response["temperature"] = temp;
-  response["voltage"] = analogRead(A0);
+  DynamicJsonDocument httpBatch;
+  DynamicJsonDocument mqttState;
+  JsonArray readings;
+  JsonObject state;
+};
+
+void trackUpload(int result) {
+  if (uploadsPending > 0) {
+    uploadsPending--;
+  }
+
+  if (result < 200 || result >= 300) {
+    uploadFailed = true;
+  }
+}
 
-  serializeJson(response, body);
+// Feeds the gateway queue as requests complete, so a cycle with more readings
+// than the queue holds doesn't drop the rest and fail the upload without ever
+// sending them.
+void putToGateway(const char* path, const char* body) {
+  gatewayClient.waitForSpace();
 
-  if (settings.sensorPaths.count(strDeviceId) > 0) {
-    HTTPClient http;
+  uploadsPending++;
+  gatewayClient.put(path, body, trackUpload);
+}
 
-    String sensorPath = settings.sensorPaths[strDeviceId];
-    time_t now = timestamp();
-    String url = String(settings.gatewayServer) + sensorPath;
+void finishUpdateCycle(UpdateCycle& cycle) {
+  if (! cycle.readings.isNull() && cycle.readings.size() > 0) {
+    String body;
+    serializeJson(cycle.httpBatch, body);
 
-    http.begin(url);
-    http.addHeader("Content-Type", "application/json");
+    putToGateway(settings.batchPath.c_str(), body.c_str());
+  }
 
-    if (settings.hmacSecret) {
-      String signature = requestSignature(settings.hmacSecret, sensorPath, body, now);
-      http.addHeader("X-Signature-Timestamp", String(now));
-      http.addHeader("X-Signature", signature);
+  if (! cycle.state.isNull() && cycle.state.size() > 0) {
+    if (! mqttClient->sendState(cycle.mqttState)) {
+      uploadFailed = true;
     }
+  }
+}
+
+// Publishes a single reading.  In batch or aggregate mode the reading is added
+// to the cycle instead of being sent on its own.
+void updateTemperature(const SensorRecord& sensor, float temp, uint16_t voltage, time_t capturedAt, UpdateCycle& cycle) {
+  StaticJsonDocument<100> response;
+  char body[100];
 
-    http.sendRequest("PUT", body);
-    http.end();
+  response["temperature"] = temp;
+  response["voltage"] = voltage;
+  response["timestamp"] = capturedAt;
+
+  serializeJson(response, body, sizeof(body));
+
+  if (! cycle.readings.isNull()) {
+    JsonObject reading = cycle.readings.createNestedObject();
+
+    reading["id"] = sensor.id;
+    reading["alias"] = sensor.name;
+    reading["temperature"] = temp;
+    reading["voltage"] = voltage;
+    reading["timestamp"] = capturedAt;
+  } else if (sensor.httpPath[0] != 0) {
+    putToGateway(sensor.httpPath, body);
   }
 
-  if (mqttClient != NULL) {
-    String topic = settings.mqttTopic;
-    topic += "/";
-    topic += deviceName;
-    topic.replace(" ", "_");
+  if (! cycle.state.isNull()) {
+    // Buffered uploads may carry several readings per sensor; the last (most
+    // recent) one wins
+    JsonObject sensorState = cycle.state.createNestedObject(sensor.name);
 
-    mqttClient->sendUpdate(deviceName, body.c_str());
+    sensorState["temperature"] = temp;
+    sensorState["voltage"] = voltage;
+    sensorState["timestamp"] = capturedAt;
+  }
+
+  if (mqttClient != NULL && settings.mqttPerSensorTopics) {
+    if (! mqttClient->sendUpdate(sensor, body)) {
+      uploadFailed = true;
+    }
   }
 }
 
 void startSettingsServer() {
-  server = new ThermometerWebserver(tempIface, settings);
+  server = new ThermometerWebserver(tempIface, sensorRegistry, settings, stats);
   server->begin();
 }
 
+void enterSettingsMode() {
+  Serial.println("Entering settings mode");
+  operatingState = OperatingState::SETTINGS;
+  startSettingsServer();
+}
+
+// Applies the flag server's answer once it's available.  The probe runs in the
+// background while sensors are read and updates are published.
+void checkFlagServer() {
+  if (operatingState != OperatingState::UNCHECKED || !flagServerProbe.isDone()) {
+    return;
+  }
+
+  if (flagServerProbe.isUpdateRequested()) {
+    enterSettingsMode();
+  } else {
+    operatingState = OperatingState::NORMAL;
+  }
+}
+
 bool isSettingsMode() {
-  if (settings.opMode == OperatingMode::ALWAYS_ON) {
-    operatingState = OperatingState::SETTINGS;
+  return operatingState == OperatingState::SETTINGS;
+}
+
+void connectWifiFull() {
+  WiFiManager wifiManager;
+  wifiManager.setConfigPortalTimeout(180);
+
+  char apName[50];
+  sprintf(apName, "Thermometer_%d", ESP.getChipId());
+  wifiManager.autoConnect(apName, "fireitup");
+
+  if (!WiFi.isConnected()) {
+    Serial.println("Timed out trying to connect, going to reboot");
+    ESP.restart();
+  }
+}
+
+bool connectWifiFast() {
+  RtcWifiCache& cache = rtcState.data.wifi;
+
+  if (cache.uses == 0 || cache.uses > WIFI_FAST_CONNECT_MAX_USES) {
+    return false;
+  }
+
+  // SSID and passphrase come from the SDK's saved station config
+  String ssid = WiFi.SSID();
+  String psk = WiFi.psk();
+
+  if (ssid.length() == 0) {
+    return false;
+  }
+
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+  WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+  WiFi.begin(ssid.c_str(), psk.c_str(), cache.channel, cache.bssid);
+
+  unsigned long start = millis();
+  while (!WiFi.isConnected() && (millis() - start) < WIFI_FAST_CONNECT_TIMEOUT) {
+    delay(10);
+  }
+
+  if (WiFi.isConnected()) {
+    cache.uses++;
     return true;
   }
 
-  if (operatingState != OperatingState::UNCHECKED) {
-    return operatingState == OperatingState::SETTINGS;
+  Serial.println(F("Fast reconnect failed, falling back to full connect"));
+
+  // Go back to DHCP for the full path, and let credentials entered in the
+  // config portal be saved to flash again
+  cache.uses = 0;
+  WiFi.disconnect();
+  WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
+  WiFi.persistent(true);
+
+  return false;
+}
+
+void cacheWifiConnection() {
+  RtcWifiCache& cache = rtcState.data.wifi;
+
+  memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+  cache.channel = WiFi.channel();
+  cache.ip = WiFi.localIP();
+  cache.gateway = WiFi.gatewayIP();
+  cache.subnet = WiFi.subnetMask();
+  cache.dns = WiFi.dnsIP(0);
+  cache.uses = 1;
+}
+
+void connectWifi() {
+  unsigned long start = millis();
+
+  stats.wifiFastConnect = connectWifiFast();
+
+  if (! stats.wifiFastConnect) {
+    connectWifiFull();
+    cacheWifiConnection();
   }
 
-  if (settings.requiredSettingsDefined()) {
-    WiFiClient client;
+  stats.wifiConnectMillis = millis() - start;
 
-    if (client.connect(settings.flagServer.c_str(), settings.flagServerPort)) {
-      Serial.println("Connected to flag server");
-      String response = client.readString();
+  Serial.printf_P(
+    PSTR("WiFi connected in %lu ms (%s)\n"),
+    stats.wifiConnectMillis,
+    stats.wifiFastConnect ? "fast" : "full"
+  );
+}
 
-      if (response == "update") {
-        operatingState = OperatingState::SETTINGS;
-      }
-    } else {
-      Serial.println("Failed to connect to flag server");
-      operatingState = OperatingState::NORMAL;
+void restoreClock() {
+  RtcClock& clock = rtcState.data.clock;
+
+  // Correct for the measured sleep timer error, and count time spent booting
+  int32_t correction = (static_cast<int64_t>(clock.sleepSeconds) * clock.driftPpm) / 1000000;
+  restoredEpoch = clock.wakeEpoch + correction + (millis() / 1000);
+  restoredAt = millis();
+
+  setTime(restoredEpoch);
+}
+
+bool shouldSyncClock() {
+  const RtcClock& clock = rtcState.data.clock;
+  uint32_t estimatedDrift = (static_cast<uint64_t>(clock.secondsSinceSync) * DEEP_SLEEP_CLOCK_UNCERTAINTY_PPM) / 1000000;
+
+  return clock.wakesSinceSync >= settings.ntpSyncEvery || estimatedDrift > settings.maxClockDrift;
+}
+
+void handleClockSync() {
+  RtcClock& clock = rtcState.data.clock;
+
+  if (restoredEpoch > 0 && clock.secondsSinceSync >= MIN_DRIFT_CALIBRATION_SECONDS) {
+    time_t estimate = restoredEpoch + ((millis() - restoredAt) / 1000);
+    int32_t error = now() - estimate;
+    int32_t ppm = clock.driftPpm + (static_cast<int64_t>(error) * 1000000) / clock.secondsSinceSync;
+
+    clock.driftPpm = constrain(ppm, -MAX_DRIFT_PPM, MAX_DRIFT_PPM);
+
+    Serial.printf_P(PSTR("NTP sync: restored clock was off by %d s, drift now %d ppm\n"), error, clock.driftPpm);
+  }
+
+  clock.secondsSinceSync = 0;
+  clock.wakesSinceSync = 0;
+}
+
+// Picks adaptive resolution back up where the last wake left it
+void restoreProbeStates() {
+  uint8_t addr[8];
+
+  for (size_t i = 0; i < tempIface.probeCount(); ++i) {
+    uint64_t rom = tempIface.probe(i).rom;
+    SensorRegistry::romToAddress(rom, addr);
+    const RtcProbeState* state = rtcState.findProbe(addr);
+
+    if (state != NULL) {
+      float temperature = state->temperature == RTC_NO_TEMPERATURE
+        ? TEMP_IFACE_NO_READING
+        : state->temperature / 100.0f;
+
+      tempIface.restore(rom, temperature, state->storedResolution, state->adaptiveResolution);
     }
-  } else {
-    operatingState = OperatingState::SETTINGS;
   }
+}
 
-  return operatingState == OperatingState::SETTINGS;
+void saveProbeStates() {
+  uint8_t addr[8];
+
+  for (size_t i = 0; i < tempIface.probeCount(); ++i) {
+    const TempIface::Probe& probe = tempIface.probe(i);
+    bool hasReading = probe.status == TempIface::ProbeStatus::OK || probe.status == TempIface::ProbeStatus::RESTORED;
+    RtcProbeState state;
+
+    state.temperature = hasReading ? lroundf(probe.temperature * 100) : RTC_NO_TEMPERATURE;
+    state.storedResolution = probe.storedResolution;
+    state.adaptiveResolution = probe.adaptiveResolution;
+
+    SensorRegistry::romToAddress(probe.rom, addr);
+
+    if (! rtcState.saveProbe(addr, state)) {
+      Serial.printf_P(PSTR("No room in RTC memory to save the state of %s\n"), sensorRegistry.find(probe.rom)->id);
+    }
+  }
 }
 
 void setup() {
@@ -138,21 +411,37 @@ void setup() {
     Serial.println("Failed to initialize SPFFS");
   }
 
-  WiFiManager wifiManager;
-  wifiManager.setConfigPortalTimeout(180);
+  Settings::load(settings);
 
-  char apName[50];
-  sprintf(apName, "Thermometer_%d", ESP.getChipId());
-  wifiManager.autoConnect(apName, "fireitup");
+  bool rtcValid = rtcState.load();
+  stats.readingsNotBuffered = rtcState.data.readingsNotBuffered;
+  bool deepSleepWake = ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE;
 
-  if (!WiFi.isConnected()) {
-    Serial.println("Timed out trying to connect, going to reboot");
-    ESP.restart();
+  if (settings.opMode == OperatingMode::DEEP_SLEEP && rtcValid && deepSleepWake && !rtcState.data.nextWakeUploads) {
+    radioEnabled = false;
   }
 
-  NTP.begin();
+  bool clockRestored = false;
+  if (rtcValid && deepSleepWake && rtcState.data.clock.wakeEpoch > 0) {
+    restoreClock();
+    clockRestored = true;
+  }
 
-  Settings::load(settings);
+  if (radioEnabled) {
+    connectWifi();
+
+    if (settings.opMode == OperatingMode::DEEP_SLEEP && settings.requiredSettingsDefined()) {
+      flagServerProbe.begin(settings.flagServer.c_str(), settings.flagServerPort, settings.flagServerTimeout);
+    }
+
+    if (! clockRestored || shouldSyncClock()) {
+      NTP.begin();
+      ntpSyncPending = true;
+    }
+  } else {
+    Serial.println(F("Sampling-only wake, radio disabled"));
+    operatingState = OperatingState::NORMAL;
+  }
 
   oneWire = new OneWire(settings.sensorBusPin);
   sensors = new DallasTemperature(oneWire);
@@ -160,50 +449,220 @@ void setup() {
 
   tempIface.begin();
 
+  if (rtcValid && deepSleepWake) {
+    restoreProbeStates();
+  }
+
+  if (! radioEnabled) {
+    return;
+  }
+
   if (settings._mqttServer.length() > 0) {
     mqttClient = new MqttClient(settings);
     mqttClient->begin();
   }
 
-  if (isSettingsMode()) {
-    Serial.println("Entering settings mode");
-    startSettingsServer();
+  if (settings.opMode == OperatingMode::ALWAYS_ON || !settings.requiredSettingsDefined()) {
+    enterSettingsMode();
   }
 }
 
-void sendUpdates() {
+void publishReadings() {
+  sensorRegistry.refresh();
+  UpdateCycle cycle(tempIface.probeCount());
+
+  for (size_t i = 0; i < tempIface.probeCount(); ++i) {
+    const TempIface::Probe& probe = tempIface.probe(i);
+    updateTemperature(*sensorRegistry.find(probe.rom), probe.temperature, analogRead(A0), now(), cycle);
+  }
+
+  finishUpdateCycle(cycle);
+}
+
+void bufferReadings() {
+  uint16_t voltage = analogRead(A0);
+  time_t n = now();
+  uint8_t addr[8];
+
+  for (size_t i = 0; i < tempIface.probeCount(); ++i) {
+    const TempIface::Probe& probe = tempIface.probe(i);
+
+    SensorRegistry::romToAddress(probe.rom, addr);
+
+    if (! rtcState.append(addr, probe.temperature, voltage, n)) {
+      Serial.printf_P(
+        PSTR("No room in RTC memory for a reading from %s (%u probes max)\n"),
+        sensorRegistry.find(probe.rom)->id,
+        RTC_MAX_SENSORS
+      );
+      unbufferedProbes.push_back(i);
+    }
+  }
+
+  stats.readingsNotBuffered = rtcState.data.readingsNotBuffered;
+}
+
+void uploadBufferedReadings() {
   uint8_t addr[8];
-  for (uint8_t i = 0; i < sensors->getDeviceCount(); ++i) {
-    sensors->getAddress(addr, i);
-    sensors->requestTemperaturesByAddress(addr);
+  float temp;
+  uint16_t voltage;
+  time_t capturedAt;
+
+  Serial.printf_P(PSTR("Uploading %u buffered readings\n"), rtcState.readingCount());
 
-    updateTemperature(addr, sensors->getTempF(addr));
+  uploadsPending = 0;
+  uploadFailed = false;
+
+  // Buffered readings can belong to probes that aren't on the bus this boot.
+  // Register them before the cycle holds references into the registry.
+  for (size_t i = 0; i < rtcState.readingCount(); ++i) {
+    if (rtcState.getReading(i, addr, temp, voltage, capturedAt)) {
+      sensorRegistry.add(addr);
+    }
+  }
+
+  sensorRegistry.refresh();
+  UpdateCycle cycle(rtcState.readingCount() + unbufferedProbes.size());
+
+  for (size_t i = 0; i < rtcState.readingCount(); ++i) {
+    if (rtcState.getReading(i, addr, temp, voltage, capturedAt)) {
+      updateTemperature(*sensorRegistry.find(addr), temp, voltage, capturedAt, cycle);
+    }
+  }
+
+  // Sent once whether or not the upload succeeds; there's nowhere to keep them
+  voltage = analogRead(A0);
+  for (std::vector<size_t>::iterator itr = unbufferedProbes.begin(); itr != unbufferedProbes.end(); ++itr) {
+    const TempIface::Probe& probe = tempIface.probe(*itr);
+    updateTemperature(*sensorRegistry.find(probe.rom), probe.temperature, voltage, now(), cycle);
+  }
+
+  unbufferedProbes.clear();
+  finishUpdateCycle(cycle);
+}
+
+// Called once the gateway has been flushed.  Readings from a failed upload stay
+// buffered (up to RTC_READING_CAPACITY, oldest dropped first) and are retried on
+// the next wake, which uploads because wakesSinceUpload wasn't reset.
+void finishBufferedUpload() {
+  if (uploadFailed || uploadsPending > 0) {
+    Serial.printf_P(PSTR("Upload failed, keeping %u buffered readings\n"), rtcState.readingCount());
+  } else {
+    rtcState.clearReadings();
+  }
+}
+
+// Decides whether the next wake needs the radio.  It does if the upload cadence
+// is due, or if the wake after it would overflow the batch.
+bool shouldUploadNextWake() {
+  size_t limit = RTC_READING_CAPACITY;
+  size_t perWake = tempIface.probeCount();
+
+  if (settings.batchSize > 0 && settings.batchSize < limit) {
+    limit = settings.batchSize;
+  }
+
+  return (rtcState.data.wakesSinceUpload + 1) >= settings.uploadEvery
+    || (rtcState.readingCount() + 2 * perWake) > limit;
+}
+
+void enterDeepSleep() {
+  bool uploadNext = shouldUploadNextWake();
+
+  rtcState.data.nextWakeUploads = uploadNext;
+
+  RtcClock& clock = rtcState.data.clock;
+  clock.sleepSeconds = settings.updateInterval;
+  clock.wakeEpoch = now() + settings.updateInterval;
+  clock.secondsSinceSync += settings.updateInterval;
+  clock.wakesSinceSync++;
+
+  saveProbeStates();
+  rtcState.save();
+
+  Serial.println();
+  Serial.printf_P(PSTR("going to sleep, next wake %s\n"), uploadNext ? "uploads" : "samples only");
+
+  if (radioEnabled) {
+    Serial.println("closing connection.");
+    delay(1000);
+  }
+
+  ESP.deepSleep(settings.updateInterval * 1000000L, uploadNext ? WAKE_RF_DEFAULT : WAKE_RF_DISABLED);
+}
+
+void sendUpdates() {
+  // Only go back to the bus if the cached readings are stale
+  if (! tempIface.hasFreshReadings(settings.maxReadingAge * 1000)) {
+    tempIface.readAll();
+
+    Serial.printf_P(
+      PSTR("Sensor phase took %lu ms for %u probes\n"),
+      tempIface.lastReadDuration(),
+      tempIface.probeCount()
+    );
+  }
+
+  bufferReadings();
+
+  if (radioEnabled) {
+    uploadBufferedReadings();
+  } else {
+    rtcState.data.wakesSinceUpload++;
   }
 }
 
 void loop() {
-  while (!NTP.getFirstSync()) {
-    yield();
+  if (ntpSyncPending) {
+    while (!NTP.getFirstSync()) {
+      yield();
+    }
+
+    handleClockSync();
+    ntpSyncPending = false;
   }
 
   tempIface.loop();
+  gatewayClient.loop();
+  checkFlagServer();
 
   if (isSettingsMode()) {
     time_t n = now();
 
     if (n > (lastUpdate + settings.updateInterval)) {
-      sendUpdates();
+      if (tempIface.hasFreshReadings(settings.maxReadingAge * 1000)) {
+        publishReadings();
+      } else {
+        // Publish once the conversion finishes rather than blocking the loop
+        tempIface.requestConversion();
+        updatePending = true;
+      }
       lastUpdate = n;
     }
+
+    if (updatePending && tempIface.isIdle()) {
+      publishReadings();
+      updatePending = false;
+    }
   } else {
     sendUpdates();
+    gatewayClient.flush(GATEWAY_FLUSH_TIMEOUT);
 
-    Serial.println();
-    Serial.println("closing connection. going to sleep...");
+    if (radioEnabled) {
+      finishBufferedUpload();
+    }
 
-    delay(1000);
+    // Honor the flag server before going to sleep
+    while (flagServerProbe.isStarted() && !flagServerProbe.isDone()) {
+      delay(1);
+    }
+    checkFlagServer();
 
-    ESP.deepSleep(settings.updateInterval * 1000000L, WAKE_RF_DEFAULT);
+    if (isSettingsMode()) {
+      lastUpdate = now();
+    } else {
+      enterDeepSleep();
+    }
   }
 
   if (mqttClient) {
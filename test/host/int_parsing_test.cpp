@@ -0,0 +1,241 @@
+// Checks the table-driven hex routines in IntParsing.h against the
+// sprintf/branching implementations they replaced, then times both on 8-byte
+// ROM ids and long hex strings.
+
+#include <IntParsing.h>
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+// The implementations replaced by the lookup tables, kept for comparison
+
+template <typename T>
+static T legacyStrToHex(const char* s, size_t length) {
+  T value = 0;
+  T base = 1;
+
+  for (int i = length-1; i >= 0; i--) {
+    const char c = s[i];
+
+    if (c >= '0' && c <= '9') {
+      value += ((c - '0') * base);
+    } else if (c >= 'a' && c <= 'f') {
+      value += ((c - 'a' + 10) * base);
+    } else if (c >= 'A' && c <= 'F') {
+      value += ((c - 'A' + 10) * base);
+    } else {
+      break;
+    }
+
+    base <<= 4;
+  }
+
+  return value;
+}
+
+template <typename T>
+static void legacyHexStrToBytes(const char* s, const size_t sLen, T* buffer, size_t maxLen) {
+  size_t idx = 0;
+
+  for (size_t i = 0; i < sLen && idx < maxLen; ) {
+    buffer[idx++] = legacyStrToHex<T>(s+i, 2);
+    i+= 2;
+
+    while (i < (sLen - 1) && s[i] == ' ') {
+      i++;
+    }
+  }
+}
+
+static void legacyBytesToHexStr(const uint8_t* bytes, const size_t len, char* buffer, size_t maxLen) {
+  char* p = buffer;
+
+  for (size_t i = 0; i < len && static_cast<size_t>(p - buffer) < (maxLen - 2); i++) {
+    p += sprintf(p, "%02X", bytes[i]);
+  }
+}
+
+static bool legacyParseId(const char* id, uint64_t& rom) {
+  rom = 0;
+
+  for (size_t i = 0; i < 16; i++) {
+    if (! isxdigit(id[i])) {
+      return false;
+    }
+
+    rom = (rom << 4) | legacyStrToHex<uint8_t>(id + i, 1);
+  }
+
+  return id[16] == 0;
+}
+
+// As in SensorRegistry::parseId()
+static bool parseId(const char* id, uint64_t& rom) {
+  return parseHex(id, 16, rom) && id[16] == 0;
+}
+
+static int failures = 0;
+
+static void expect(bool condition, const char* description) {
+  if (! condition) {
+    printf("FAIL %s\n", description);
+    failures++;
+  }
+}
+
+static void checkAgainstLegacy() {
+  for (int c = 0; c < 256; c++) {
+    char s[2] = { static_cast<char>(c), 0 };
+    uint8_t expected = isxdigit(c) ? legacyStrToHex<uint8_t>(s, 1) : INVALID_HEX_DIGIT;
+
+    if (hexDigitValue(static_cast<char>(c)) != expected) {
+      printf("FAIL hexDigitValue(0x%02x)\n", c);
+      failures++;
+    }
+
+    uint8_t byte = c;
+    char legacy[3];
+    char encoded[3];
+    legacyBytesToHexStr(&byte, 1, legacy, sizeof(legacy));
+    IntParsing::bytesToHexStr(&byte, 1, encoded, sizeof(encoded));
+
+    if (strcmp(legacy, encoded) != 0) {
+      printf("FAIL bytesToHexStr(0x%02x): got %s, expected %s\n", c, encoded, legacy);
+      failures++;
+    }
+  }
+
+  static const char* IDS[] = {
+    "28FF4A1B02160391",
+    "28ff4a1b02160391",
+    "0000000000000000",
+    "FFFFFFFFFFFFFFFF",
+    "28FF4A1B0216039",
+    "28FF4A1B021603910",
+    "28FF4A1B0216039G",
+    "28FF4A1B 2160391",
+    ""
+  };
+
+  for (size_t i = 0; i < sizeof(IDS) / sizeof(IDS[0]); i++) {
+    uint64_t legacy = 0;
+    uint64_t parsed = 0;
+    bool legacyValid = legacyParseId(IDS[i], legacy);
+    bool valid = parseId(IDS[i], parsed);
+
+    if (legacyValid != valid || (valid && legacy != parsed)) {
+      printf("FAIL parseId(\"%s\")\n", IDS[i]);
+      failures++;
+    }
+  }
+
+  static const uint8_t ADDRESS[8] = { 0x28, 0xFF, 0x4A, 0x1B, 0x02, 0x16, 0x03, 0x91 };
+  char id[17];
+  char truncated[6];
+  expect(IntParsing::bytesToHexStr(ADDRESS, 8, id, sizeof(id)) == 16, "bytesToHexStr length");
+  expect(strcmp(id, "28FF4A1B02160391") == 0, "bytesToHexStr ROM id");
+  expect(IntParsing::bytesToHexStr(ADDRESS, 8, truncated, sizeof(truncated)) == 4, "bytesToHexStr bounded length");
+  expect(strcmp(truncated, "28FF") == 0, "bytesToHexStr writes whole bytes only");
+
+  expect(strToHex<uint64_t>(String("28ff4a1b02160391")) == 0x28ff4a1b02160391ULL, "strToHex 64 bit");
+  expect(parseInt<uint16_t>(String("0x1F")) == 0x1F, "parseInt hex");
+  expect(parseInt<int>(String("42")) == 42, "parseInt decimal");
+
+  uint32_t value = 7;
+  expect(! parseHex("123456789", 9, value) && value == 7, "parseHex rejects overflow");
+  expect(! parseHex("12g4", 4, value) && value == 7, "parseHex rejects invalid digits");
+
+  const char* spaced = "de ad  be ef";
+  uint8_t legacyBytes[4] = { 0 };
+  uint8_t bytes[4] = { 0 };
+  legacyHexStrToBytes(spaced, strlen(spaced), legacyBytes, 4);
+  expect(hexStrToBytes(spaced, strlen(spaced), bytes, 4) == 4, "hexStrToBytes count");
+  expect(memcmp(legacyBytes, bytes, 4) == 0, "hexStrToBytes with spaces");
+}
+
+static volatile uint64_t sink;
+
+template <typename F>
+static double nanosecondsPer(size_t iterations, F f) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < iterations; i++) {
+    f(i);
+  }
+
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void benchmark() {
+  static const size_t ITERATIONS = 2000000;
+  static const size_t LONG_ITERATIONS = 4000;
+
+  static uint8_t roms[64][8];
+  static char ids[64][17];
+  static uint8_t bytes[1024];
+  static char hex[2049];
+  static uint8_t decoded[1024];
+  char id[17];
+
+  for (size_t i = 0; i < 64; i++) {
+    for (size_t j = 0; j < 8; j++) {
+      roms[i][j] = i * 37 + j * 101;
+    }
+
+    IntParsing::bytesToHexStr(roms[i], 8, ids[i], sizeof(ids[i]));
+  }
+
+  for (size_t i = 0; i < sizeof(bytes); i++) {
+    bytes[i] = i * 13;
+  }
+
+  printf("Hex routines (ns/op)        legacy    table\n");
+
+  printf(
+    "  encode 8-byte ROM id    %9.1f %8.1f\n",
+    nanosecondsPer(ITERATIONS, [&](size_t i) { legacyBytesToHexStr(roms[i & 63], 8, id, sizeof(id)); sink += id[3]; }),
+    nanosecondsPer(ITERATIONS, [&](size_t i) { IntParsing::bytesToHexStr(roms[i & 63], 8, id, sizeof(id)); sink += id[3]; })
+  );
+
+  printf(
+    "  parse 16-char ROM id    %9.1f %8.1f\n",
+    nanosecondsPer(ITERATIONS, [&](size_t i) { uint64_t rom = 0; legacyParseId(ids[i & 63], rom); sink += rom; }),
+    nanosecondsPer(ITERATIONS, [&](size_t i) { uint64_t rom = 0; parseId(ids[i & 63], rom); sink += rom; })
+  );
+
+  printf(
+    "  strToHex 16 chars       %9.1f %8.1f\n",
+    nanosecondsPer(ITERATIONS, [&](size_t i) { sink += legacyStrToHex<uint64_t>(ids[i & 63], 16); }),
+    nanosecondsPer(ITERATIONS, [&](size_t i) { sink += strToHex<uint64_t>(ids[i & 63], 16); })
+  );
+
+  printf(
+    "  encode 1 KiB            %9.0f %8.0f\n",
+    nanosecondsPer(LONG_ITERATIONS, [&](size_t) { legacyBytesToHexStr(bytes, sizeof(bytes), hex, sizeof(hex)); sink += hex[7]; }),
+    nanosecondsPer(LONG_ITERATIONS, [&](size_t) { IntParsing::bytesToHexStr(bytes, sizeof(bytes), hex, sizeof(hex)); sink += hex[7]; })
+  );
+
+  printf(
+    "  decode 2048 hex chars   %9.0f %8.0f\n",
+    nanosecondsPer(LONG_ITERATIONS, [&](size_t) { legacyHexStrToBytes(hex, 2048, decoded, sizeof(decoded)); sink += decoded[5]; }),
+    nanosecondsPer(LONG_ITERATIONS, [&](size_t) { hexStrToBytes(hex, 2048, decoded, sizeof(decoded)); sink += decoded[5]; })
+  );
+
+  expect(memcmp(bytes, decoded, sizeof(bytes)) == 0, "1 KiB round trip");
+}
+
+int main() {
+  checkAgainstLegacy();
+
+  if (failures > 0) {
+    printf("int_parsing_test: %d failures\n", failures);
+    return 1;
+  }
+
+  printf("int_parsing_test: all checks passed\n");
+  benchmark();
+
+  return failures > 0;
+}
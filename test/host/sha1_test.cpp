@@ -0,0 +1,202 @@
+// Checks Sha1Class and RequestSigner against published SHA-1 and HMAC-SHA1
+// test vectors, feeding input in chunk sizes that exercise the partial-block
+// and whole-block paths of write().  Then times the per-byte path against the
+// block path.
+
+#include <sha1.h>
+#include <HmacHelpers.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+struct HashVector {
+  const char* name;
+  std::string message;
+  const char* digest;
+};
+
+struct HmacVector {
+  const char* name;
+  std::string key;
+  std::string message;
+  const char* digest;
+};
+
+// FIPS 180-2 appendix A, plus the empty message
+static const HashVector HASH_VECTORS[] = {
+  { "empty", "", "da39a3ee5e6b4b0d3255bfef95601890afd80709" },
+  { "abc", "abc", "a9993e364706816aba3e25717850c26c9cd0d89d" },
+  {
+    "448 bits",
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    "84983e441c3bd26ebaae4aa1f95129e5e54670f1"
+  },
+  {
+    "896 bits",
+    "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+    "a49b2446a02c645bf419f995b67091253a04a259"
+  },
+  { "million a", std::string(1000000, 'a'), "34aa973cd4c4daa4f61eeb2bdbad27316534016f" },
+};
+
+// RFC 2202 section 3
+static const HmacVector HMAC_VECTORS[] = {
+  { "rfc2202 1", std::string(20, '\x0b'), "Hi There", "b617318655057264e28bc0b6fb378c8ef146be00" },
+  { "rfc2202 2", "Jefe", "what do ya want for nothing?", "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79" },
+  { "rfc2202 3", std::string(20, '\xaa'), std::string(50, '\xdd'), "125d7342b9ac11cd91a39af48aa17b4f63f175d3" },
+  {
+    "rfc2202 6",
+    std::string(80, '\xaa'),
+    "Test Using Larger Than Block-Size Key - Hash Key First",
+    "aa4ae5e15272d00e95705637ce8a3b55ed402112"
+  },
+  {
+    "rfc2202 7",
+    std::string(80, '\xaa'),
+    "Test Using Larger Than Block-Size Key and Larger Than One Block-Size Data",
+    "e8e99d0f45237d786d6bbaa7965c7808bbff1a91"
+  },
+};
+
+// 1 exercises the per-byte path; the rest straddle block boundaries
+static const size_t CHUNK_SIZES[] = { 1, 3, 63, 64, 65, 1000 };
+
+static int failures = 0;
+
+static void check(const char* name, size_t chunkSize, const uint8_t* digest, const char* expected) {
+  char hex[HMAC_HEX_LENGTH + 1];
+  bin2hex(digest, HASH_LENGTH, hex);
+
+  if (strcmp(hex, expected) != 0) {
+    printf("FAIL %s (%u byte writes): got %s, expected %s\n", name, (unsigned)chunkSize, hex, expected);
+    failures++;
+  }
+}
+
+static void writeChunked(const std::string& message, size_t chunkSize) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(message.data());
+
+  for (size_t i = 0; i < message.size(); i += chunkSize) {
+    size_t n = std::min(chunkSize, message.size() - i);
+
+    if (chunkSize == 1) {
+      Sha1.write(data[i]);
+    } else {
+      Sha1.write(data + i, n);
+    }
+  }
+}
+
+static void checkVectors() {
+  for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); c++) {
+    size_t chunkSize = CHUNK_SIZES[c];
+
+    for (size_t i = 0; i < sizeof(HASH_VECTORS) / sizeof(HASH_VECTORS[0]); i++) {
+      const HashVector& v = HASH_VECTORS[i];
+
+      Sha1.init();
+      writeChunked(v.message, chunkSize);
+      check(v.name, chunkSize, Sha1.result(), v.digest);
+    }
+
+    for (size_t i = 0; i < sizeof(HMAC_VECTORS) / sizeof(HMAC_VECTORS[0]); i++) {
+      const HmacVector& v = HMAC_VECTORS[i];
+      const uint8_t* key = reinterpret_cast<const uint8_t*>(v.key.data());
+
+      Sha1.initHmac(key, v.key.size());
+      writeChunked(v.message, chunkSize);
+      check(v.name, chunkSize, Sha1.resultHmac(), v.digest);
+
+      // Same again from a prepared key
+      Sha1HmacKey prepared;
+      Sha1.prepareHmacKey(key, v.key.size(), prepared);
+      Sha1.initHmac(prepared);
+      writeChunked(v.message, chunkSize);
+      check(v.name, chunkSize, Sha1.resultHmac(prepared), v.digest);
+    }
+  }
+
+  // Source buffers needn't be word aligned
+  std::vector<uint8_t> buffer(1 + 3 * BLOCK_LENGTH);
+  memcpy(&buffer[1], "abc", 3);
+  Sha1.init();
+  Sha1.write(&buffer[1], 3);
+  check("unaligned abc", 3, Sha1.result(), "a9993e364706816aba3e25717850c26c9cd0d89d");
+
+  // RequestSigner hashes path, body and timestamp as one message
+  RequestSigner signer;
+  char signature[HMAC_HEX_LENGTH + 1];
+  signer.setKey("Jefe", 4);
+  signer.sign("what do ya", 10, " want for nothing", 17, 0, signature);
+
+  Sha1.initHmac(reinterpret_cast<const uint8_t*>("Jefe"), 4);
+  writeChunked("what do ya want for nothing0", 7);
+  char expected[HMAC_HEX_LENGTH + 1];
+  bin2hex(Sha1.resultHmac(), HASH_LENGTH, expected);
+
+  if (strcmp(signature, expected) != 0) {
+    printf("FAIL RequestSigner: got %s, expected %s\n", signature, expected);
+    failures++;
+  }
+}
+
+static double megabytesPerSecond(size_t messageSize, bool perByte) {
+  std::vector<uint8_t> message(messageSize);
+  size_t iterations = (64 << 20) / messageSize;
+
+  for (size_t i = 0; i < messageSize; i++) {
+    message[i] = i * 31 + 7;
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < iterations; i++) {
+    Sha1.init();
+
+    if (perByte) {
+      for (size_t j = 0; j < messageSize; j++) {
+        Sha1.write(message[j]);
+      }
+    } else {
+      Sha1.write(message.data(), messageSize);
+    }
+
+    Sha1.result();
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  return (iterations * messageSize) / seconds / 1e6;
+}
+
+static void benchmark() {
+  static const size_t MESSAGE_SIZES[] = { 64, 256, 1 << 20 };
+
+  printf("SHA-1 throughput (MB/s)   per-byte    block\n");
+
+  for (size_t i = 0; i < sizeof(MESSAGE_SIZES) / sizeof(MESSAGE_SIZES[0]); i++) {
+    printf(
+      "  %7u-byte messages  %9.1f %8.1f\n",
+      (unsigned)MESSAGE_SIZES[i],
+      megabytesPerSecond(MESSAGE_SIZES[i], true),
+      megabytesPerSecond(MESSAGE_SIZES[i], false)
+    );
+  }
+}
+
+int main() {
+  checkVectors();
+
+  if (failures > 0) {
+    printf("sha1_test: %d failures\n", failures);
+    return 1;
+  }
+
+  printf("sha1_test: all vectors passed\n");
+  benchmark();
+
+  return 0;
+}
@@ -0,0 +1,29 @@
+// Just enough of the Arduino core to build the libraries under test on the host
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+#include <Print.h>
+#include <pgmspace.h>
+
+class String {
+public:
+  String(const char* s = "") : s(s) { }
+
+  const char* c_str() const { return s.c_str(); }
+  size_t length() const { return s.length(); }
+  bool startsWith(const char* prefix) const { return s.compare(0, strlen(prefix), prefix) == 0; }
+  long toInt() const { return atol(s.c_str()); }
+
+private:
+  std::string s;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef _HOST_PRINT_H
+#define _HOST_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Print {
+public:
+  virtual ~Print() { }
+
+  virtual size_t write(uint8_t) = 0;
+
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+
+    while (size--) {
+      n += write(*buffer++);
+    }
+
+    return n;
+  }
+};
+
+#endif
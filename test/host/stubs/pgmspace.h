@@ -0,0 +1,12 @@
+#ifndef _HOST_PGMSPACE_H
+#define _HOST_PGMSPACE_H
+
+#include <string.h>
+
+#define PROGMEM
+
+inline void* memcpy_P(void* dest, const void* src, size_t n) {
+  return memcpy(dest, src, n);
+}
+
+#endif
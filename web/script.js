@@ -0,0 +1,265 @@
+(function() {
+
+  var SETTING_KEYS = [
+    "mqtt.server",
+    "mqtt.topic_prefix",
+    "mqtt.username",
+    "mqtt.password",
+    "mqtt.aggregate_state",
+    "mqtt.per_sensor_topics",
+
+    "http.gateway_server",
+    "http.hmac_secret",
+    "http.batch_path",
+
+    "admin.flag_server",
+    "admin.flag_server_port",
+    "admin.flag_server_timeout",
+    "admin.username",
+    "admin.password",
+    "admin.operating_mode",
+    "admin.web_ui_port",
+    "admin.ntp_sync_every",
+    "admin.max_clock_drift",
+
+    "thermometers.update_interval",
+    "thermometers.poll_interval",
+    "thermometers.max_reading_age",
+    "thermometers.resolution",
+    "thermometers.adaptive_resolution",
+    "thermometers.upload_every",
+    "thermometers.batch_size",
+    "thermometers.sensor_bus_pin"
+  ];
+
+  var RADIO_FIELDS = {
+    "admin.operating_mode": ["always_on", "deep_sleep"],
+    "thermometers.adaptive_resolution": ["true", "false"],
+    "mqtt.aggregate_state": ["true", "false"],
+    "mqtt.per_sensor_topics": ["true", "false"]
+  };
+
+  var PASSWORD_FIELDS = {
+    "admin.password": 1,
+    "mqtt.password": 1,
+    "http.hmac_secret": 1
+  };
+
+  var currentSettings = {};
+
+  var find = function(selector, root) {
+    return (root || document).querySelector(selector);
+  };
+
+  var element = function(tag, attributes, children) {
+    var elmt = document.createElement(tag);
+
+    Object.keys(attributes || {}).forEach(function(key) {
+      elmt[key] = attributes[key];
+    });
+
+    (children || []).forEach(function(child) {
+      elmt.appendChild(typeof child === 'string' ? document.createTextNode(child) : child);
+    });
+
+    return elmt;
+  };
+
+  var titleize = function(s) {
+    return s.split(/[ _]+/).map(function(word) {
+      return word.substr(0, 1).toUpperCase() + word.substr(1);
+    }).join(' ');
+  };
+
+  var showBanner = function(message, type) {
+    var banner = find('#banner');
+    banner.textContent = message;
+    banner.className = 'alert ' + type;
+
+    clearTimeout(showBanner.timer);
+    showBanner.timer = setTimeout(function() { banner.className = 'alert hidden'; }, 4000);
+  };
+
+  var showError = function(e) {
+    console.log(e);
+    showBanner('Encountered an error', 'alert-danger');
+  };
+
+  var request = function(method, url, body) {
+    var options = {method: method, credentials: 'same-origin'};
+
+    if (body) {
+      options.headers = {'Content-Type': 'application/json'};
+      options.body = JSON.stringify(body);
+    }
+
+    return fetch(url, options).then(function(response) {
+      if (! response.ok) {
+        throw new Error(method + ' ' + url + ' failed with ' + response.status);
+      }
+
+      return response.json();
+    });
+  };
+
+  // Submits abc[def]=x, abc[xyz]=1 as {"abc":{"def":x,"xyz":1}}
+  var serializeForm = function(form) {
+    var data = {};
+
+    Array.prototype.forEach.call(form.elements, function(field) {
+      if (! field.name || field.disabled || field.type === 'submit' || (field.type === 'radio' && ! field.checked)) {
+        return;
+      }
+
+      var hashMatch = field.name.match(/([^\[]+)\[([^\]]+)\]/);
+
+      if (hashMatch) {
+        data[hashMatch[1]] = data[hashMatch[1]] || {};
+        data[hashMatch[1]][hashMatch[2]] = field.value;
+      } else {
+        data[field.name] = field.value;
+      }
+    });
+
+    return data;
+  };
+
+  var renderTextField = function(setting) {
+    return [
+      element('label', {className: 'control-label', textContent: setting.title}),
+      element('input', {
+        className: 'form-control',
+        name: setting.key,
+        type: PASSWORD_FIELDS[setting.key] ? 'password' : 'text',
+        value: setting.value === undefined ? '' : setting.value,
+        disabled: !!setting.disabled
+      })
+    ];
+  };
+
+  var renderRadioField = function(setting) {
+    var group = element('div', {className: 'btn-radio'});
+
+    RADIO_FIELDS[setting.key].forEach(function(option) {
+      group.appendChild(element('label', {className: 'btn'}, [
+        element('input', {type: 'radio', name: setting.key, value: option}),
+        titleize(option)
+      ]));
+    });
+
+    return [element('label', {className: 'control-label', textContent: setting.title}), group];
+  };
+
+  var appendAll = function(parent, children) {
+    children.forEach(function(child) { parent.appendChild(child); });
+  };
+
+  var applyThermometers = function(data) {
+    var aliases = find('#aliases-form fieldset');
+
+    if (data.length == 0) {
+      aliases.appendChild(element('i', {textContent: 'No thermometers detected.  Try checking connections and restarting'}));
+      return;
+    }
+
+    var paths = find('fieldset[data-category="http"]');
+    var temperatures = find('#current-temperatures');
+    var sensorPaths = currentSettings['http.sensor_paths'] || {};
+
+    paths.appendChild(element('h4', {textContent: 'Paths'}));
+
+    data.forEach(function(thermometer) {
+      var title = thermometer.id;
+
+      if (thermometer.name) {
+        title += ' (' + thermometer.name + ')';
+      }
+
+      appendAll(aliases, renderTextField({key: thermometer.id, title: thermometer.id, value: thermometer.name}));
+      appendAll(paths, renderTextField({
+        key: 'http.sensor_paths[' + thermometer.id + ']',
+        title: title,
+        value: sensorPaths[thermometer.id]
+      }));
+      appendAll(temperatures, renderTextField({key: '', title: title, value: thermometer.temperature, disabled: true}));
+    });
+  };
+
+  var applySettings = function(data) {
+    currentSettings = data;
+
+    Object.keys(data).forEach(function(key) {
+      var value = String(data[key]);
+
+      if (RADIO_FIELDS[key]) {
+        var radio = find('input[name="' + key + '"][value="' + value + '"]');
+
+        if (radio) {
+          radio.checked = true;
+        }
+      } else {
+        var input = find('#settings-form input[name="' + key + '"]');
+
+        if (input) {
+          input.value = value;
+        }
+      }
+    });
+  };
+
+  var saveForm = function(form, transform) {
+    form.addEventListener('submit', function(e) {
+      e.preventDefault();
+
+      request('PUT', '/settings', transform(serializeForm(form)))
+        .then(function() { showBanner('Saved', 'alert-success'); })
+        .catch(showError);
+    });
+  };
+
+  var buildSettingsForm = function() {
+    var form = find('#settings-form');
+    var submit = find('button', form);
+    var keysByCategory = {};
+
+    SETTING_KEYS.forEach(function(key) {
+      var category = key.split('.')[0];
+      (keysByCategory[category] = keysByCategory[category] || []).push(key);
+    });
+
+    Object.keys(keysByCategory).forEach(function(category) {
+      var fieldset = element('fieldset', {className: 'form-group'});
+      fieldset.setAttribute('data-category', category);
+
+      keysByCategory[category].forEach(function(key) {
+        var setting = {key: key, title: titleize(key.split('.')[1])};
+        appendAll(fieldset, RADIO_FIELDS[key] ? renderRadioField(setting) : renderTextField(setting));
+      });
+
+      form.insertBefore(element('h3', {className: 'category-title', textContent: titleize(category)}), submit);
+      form.insertBefore(fieldset, submit);
+    });
+  };
+
+  document.addEventListener('DOMContentLoaded', function() {
+    buildSettingsForm();
+
+    saveForm(find('#settings-form'), function(data) { return data; });
+    saveForm(find('#aliases-form'), function(data) { return {"thermometers.aliases": data}; });
+
+    find('.command-form').addEventListener('submit', function(e) {
+      e.preventDefault();
+
+      request('POST', '/commands', serializeForm(this))
+        .catch(function() { /* The device restarts before replying */ });
+      showBanner('Sent', 'alert-success');
+    });
+
+    request('GET', '/settings')
+      .then(applySettings)
+      .then(function() { return request('GET', '/thermometers'); })
+      .then(applyThermometers)
+      .catch(showError);
+  });
+
+})();